@@ -0,0 +1,255 @@
+#include "argb.h"
+
+#include <math.h>
+#include <stddef.h>
+
+// SSE2 is baseline on x64 and on any x86 build targeting it; define
+// ARGB_NO_SIMD to force the scalar paths (used as the benchmark baseline)
+#if !defined(ARGB_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define ARGB_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+// Exact x / 255 rounded to nearest, for x in [0, 255 * 255]
+static inline uint32_t Div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Scale all four channels of a premultiplied pixel by weight / 255
+static inline uint32_t ScalePixel(uint32_t pixel, uint32_t weight)
+{
+    return Div255((pixel & 0xFF) * weight) |
+           Div255(((pixel >> 8) & 0xFF) * weight) << 8 |
+           Div255(((pixel >> 16) & 0xFF) * weight) << 16 |
+           Div255((pixel >> 24) * weight) << 24;
+}
+
+// Clip a rectangle to the surface; returns 0 if nothing is left
+static int ClipRect(const ArgbSurface* surface, int* left, int* top, int* right, int* bottom)
+{
+    if (*left < 0) *left = 0;
+    if (*top < 0) *top = 0;
+    if (*right > surface->width) *right = surface->width;
+    if (*bottom > surface->height) *bottom = surface->height;
+    return *left < *right && *top < *bottom;
+}
+
+#ifdef ARGB_USE_SSE2
+// Per-lane x / 255 on 16-bit lanes holding products of two bytes
+static inline __m128i Div255x8(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Spread four 32-bit per-pixel weights to the 16-bit channel lanes of the
+// two unpacked halves (pixels 0-1 and pixels 2-3)
+static inline void SpreadWeights(__m128i weights, __m128i* low, __m128i* high)
+{
+    __m128i packed = _mm_packs_epi32(weights, weights);   // w0 w1 w2 w3 w0 w1 w2 w3
+    __m128i pairs = _mm_unpacklo_epi16(packed, packed);   // w0 w0 w1 w1 w2 w2 w3 w3
+    *low = _mm_unpacklo_epi32(pairs, pairs);              // w0 x4, w1 x4
+    *high = _mm_unpackhi_epi32(pairs, pairs);             // w2 x4, w3 x4
+}
+
+// Broadcast each pixel's alpha lane to its four channel lanes
+static inline __m128i SpreadAlpha(__m128i unpacked)
+{
+    unpacked = _mm_shufflelo_epi16(unpacked, _MM_SHUFFLE(3, 3, 3, 3));
+    return _mm_shufflehi_epi16(unpacked, _MM_SHUFFLE(3, 3, 3, 3));
+}
+#endif
+
+uint32_t ArgbPremultiply(uint8_t r, uint8_t g, uint8_t b, uint8_t alpha)
+{
+    return Div255((uint32_t)b * alpha) |
+           Div255((uint32_t)g * alpha) << 8 |
+           Div255((uint32_t)r * alpha) << 16 |
+           (uint32_t)alpha << 24;
+}
+
+void ArgbFillRect(ArgbSurface* surface, int left, int top, int right, int bottom, uint32_t color)
+{
+    if (!ClipRect(surface, &left, &top, &right, &bottom)) return;
+
+    for (int y = top; y < bottom; y++) {
+        uint32_t* row = surface->pixels + (size_t)y * surface->stride;
+        int x = left;
+#ifdef ARGB_USE_SSE2
+        __m128i fill = _mm_set1_epi32((int)color);
+        for (; x + 4 <= right; x += 4) {
+            _mm_storeu_si128((__m128i*)(row + x), fill);
+        }
+#endif
+        for (; x < right; x++) {
+            row[x] = color;
+        }
+    }
+}
+
+void ArgbBlendCoverage(ArgbSurface* surface, const ArgbSurface* mask,
+                       int left, int top, int right, int bottom, uint32_t color)
+{
+    if (!ClipRect(surface, &left, &top, &right, &bottom)) return;
+    if (right > mask->width) right = mask->width;
+    if (bottom > mask->height) bottom = mask->height;
+
+#ifdef ARGB_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i source = _mm_unpacklo_epi8(_mm_set1_epi32((int)color), zero);
+#endif
+
+    for (int y = top; y < bottom; y++) {
+        uint32_t* row = surface->pixels + (size_t)y * surface->stride;
+        const uint32_t* coverageRow = mask->pixels + (size_t)y * mask->stride;
+        int x = left;
+#ifdef ARGB_USE_SSE2
+        for (; x + 4 <= right; x += 4) {
+            __m128i coverage = _mm_loadu_si128((const __m128i*)(coverageRow + x));
+            coverage = _mm_and_si128(_mm_srli_epi32(coverage, 8), _mm_set1_epi32(0xFF));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(coverage, zero)) == 0xFFFF) {
+                continue; // Most of a text row is empty
+            }
+
+            __m128i coverageLow, coverageHigh;
+            SpreadWeights(coverage, &coverageLow, &coverageHigh);
+
+            __m128i dst = _mm_loadu_si128((__m128i*)(row + x));
+            __m128i dstLow = _mm_unpacklo_epi8(dst, zero);
+            __m128i dstHigh = _mm_unpackhi_epi8(dst, zero);
+
+            // Source scaled by coverage, then source-over
+            __m128i srcLow = Div255x8(_mm_mullo_epi16(source, coverageLow));
+            __m128i srcHigh = Div255x8(_mm_mullo_epi16(source, coverageHigh));
+            dstLow = _mm_add_epi16(srcLow, Div255x8(_mm_mullo_epi16(dstLow, _mm_sub_epi16(full, SpreadAlpha(srcLow)))));
+            dstHigh = _mm_add_epi16(srcHigh, Div255x8(_mm_mullo_epi16(dstHigh, _mm_sub_epi16(full, SpreadAlpha(srcHigh)))));
+
+            _mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(dstLow, dstHigh));
+        }
+#endif
+        for (; x < right; x++) {
+            uint32_t coverage = (coverageRow[x] >> 8) & 0xFF;
+            if (coverage == 0) continue;
+            uint32_t src = ScalePixel(color, coverage);
+            row[x] = src + ScalePixel(row[x], 255 - (src >> 24));
+        }
+    }
+}
+
+// Rounded-rectangle outline shared by the corner kernels
+typedef struct {
+    float halfWidth;
+    float halfHeight;
+    float radius;
+    float borderWidth;
+    uint32_t borderColor;
+} RoundedOutline;
+
+// Weights for one pixel centre: border ring and kept interior, both 0-255
+static inline void OutlineWeights(const RoundedOutline* outline, int x, int y,
+                                  uint32_t* borderWeight, uint32_t* insideWeight)
+{
+    float qx = fabsf(x + 0.5f - outline->halfWidth) - (outline->halfWidth - outline->radius);
+    float qy = fabsf(y + 0.5f - outline->halfHeight) - (outline->halfHeight - outline->radius);
+    float ox = qx > 0.0f ? qx : 0.0f;
+    float oy = qy > 0.0f ? qy : 0.0f;
+    float inner = qx > qy ? qx : qy;
+    float distance = sqrtf(ox * ox + oy * oy) + (inner < 0.0f ? inner : 0.0f) - outline->radius;
+
+    float outside = 0.5f - distance;
+    float inside = outside - outline->borderWidth;
+    outside = outside < 0.0f ? 0.0f : (outside > 1.0f ? 1.0f : outside);
+    inside = inside < 0.0f ? 0.0f : (inside > 1.0f ? 1.0f : inside);
+
+    *insideWeight = (uint32_t)(inside * 255.0f + 0.5f);
+    *borderWeight = (uint32_t)(outside * 255.0f + 0.5f) - *insideWeight;
+}
+
+// Apply the outline to pixels [left, right) of one row
+static void RoundSpan(uint32_t* row, int y, int left, int right, const RoundedOutline* outline)
+{
+    int x = left;
+#ifdef ARGB_USE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 scale = _mm_set1_ps(255.0f);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 halfWidth = _mm_set1_ps(outline->halfWidth);
+    const __m128 straightX = _mm_set1_ps(outline->halfWidth - outline->radius);
+    const __m128 radius = _mm_set1_ps(outline->radius);
+    const __m128 borderWidth = _mm_set1_ps(outline->borderWidth);
+    const __m128i border = _mm_unpacklo_epi8(_mm_set1_epi32((int)outline->borderColor), zero);
+
+    // The vertical term is the same for the whole row
+    float qyScalar = fabsf(y + 0.5f - outline->halfHeight) - (outline->halfHeight - outline->radius);
+    const __m128 qy = _mm_set1_ps(qyScalar);
+    const __m128 oy = _mm_max_ps(qy, _mm_setzero_ps());
+
+    for (; x + 4 <= right; x += 4) {
+        __m128 px = _mm_add_ps(_mm_set_ps((float)(x + 3), (float)(x + 2), (float)(x + 1), (float)x), half);
+        __m128 qx = _mm_sub_ps(_mm_and_ps(_mm_sub_ps(px, halfWidth), absMask), straightX);
+        __m128 ox = _mm_max_ps(qx, _mm_setzero_ps());
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(ox, ox), _mm_mul_ps(oy, oy)));
+        distance = _mm_add_ps(distance, _mm_min_ps(_mm_max_ps(qx, qy), _mm_setzero_ps()));
+        distance = _mm_sub_ps(distance, radius);
+
+        __m128 outside = _mm_sub_ps(half, distance);
+        __m128 inside = _mm_sub_ps(outside, borderWidth);
+        outside = _mm_min_ps(_mm_max_ps(outside, _mm_setzero_ps()), one);
+        inside = _mm_min_ps(_mm_max_ps(inside, _mm_setzero_ps()), one);
+
+        // Match the scalar rounding (truncate after adding 0.5)
+        __m128i insideWeight = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(inside, scale), half));
+        __m128i outsideWeight = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(outside, scale), half));
+        __m128i borderWeight = _mm_sub_epi32(outsideWeight, insideWeight);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(insideWeight, _mm_set1_epi32(255))) == 0xFFFF) {
+            continue; // Fully inside, nothing to do
+        }
+
+        __m128i insideLow, insideHigh, borderLow, borderHigh;
+        SpreadWeights(insideWeight, &insideLow, &insideHigh);
+        SpreadWeights(borderWeight, &borderLow, &borderHigh);
+
+        __m128i dst = _mm_loadu_si128((__m128i*)(row + x));
+        __m128i dstLow = _mm_unpacklo_epi8(dst, zero);
+        __m128i dstHigh = _mm_unpackhi_epi8(dst, zero);
+        dstLow = _mm_add_epi16(Div255x8(_mm_mullo_epi16(border, borderLow)), Div255x8(_mm_mullo_epi16(dstLow, insideLow)));
+        dstHigh = _mm_add_epi16(Div255x8(_mm_mullo_epi16(border, borderHigh)), Div255x8(_mm_mullo_epi16(dstHigh, insideHigh)));
+        _mm_storeu_si128((__m128i*)(row + x), _mm_packus_epi16(dstLow, dstHigh));
+    }
+#endif
+    for (; x < right; x++) {
+        uint32_t borderWeight, insideWeight;
+        OutlineWeights(outline, x, y, &borderWeight, &insideWeight);
+        if (insideWeight == 255) continue;
+        row[x] = ScalePixel(outline->borderColor, borderWeight) + ScalePixel(row[x], insideWeight);
+    }
+}
+
+void ArgbRoundCorners(ArgbSurface* surface, float radius, float borderWidth, uint32_t borderColor)
+{
+    RoundedOutline outline;
+    outline.halfWidth = surface->width * 0.5f;
+    outline.halfHeight = surface->height * 0.5f;
+    outline.radius = radius;
+    outline.borderWidth = borderWidth;
+    outline.borderColor = borderColor;
+
+    // Outside this band every pixel is fully inside the outline
+    int band = (int)ceilf(radius > borderWidth ? radius : borderWidth) + 1;
+
+    for (int y = 0; y < surface->height; y++) {
+        uint32_t* row = surface->pixels + (size_t)y * surface->stride;
+        if (y < band || y >= surface->height - band || surface->width <= 2 * band) {
+            RoundSpan(row, y, 0, surface->width, &outline);
+        } else {
+            RoundSpan(row, y, 0, band, &outline);
+            RoundSpan(row, y, surface->width - band, surface->width, &outline);
+        }
+    }
+}
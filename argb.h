@@ -0,0 +1,34 @@
+#ifndef ARGB_H
+#define ARGB_H
+
+// Premultiplied 32-bit ARGB compositing kernels used to build the overlay.
+// Pixels are 0xAARRGGBB in memory order B, G, R, A, which is what a top-down
+// 32bpp DIB section and UpdateLayeredWindow expect. No Windows dependency, so
+// the kernels can be built and benchmarked on their own (see argb_bench.c).
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t* pixels;  // Top-down rows
+    int width;
+    int height;
+    int stride;        // Distance between rows, in pixels
+} ArgbSurface;
+
+// Build a premultiplied pixel from straight (non-premultiplied) components
+uint32_t ArgbPremultiply(uint8_t r, uint8_t g, uint8_t b, uint8_t alpha);
+
+// Fill a rectangle with a premultiplied color, replacing what is there
+void ArgbFillRect(ArgbSurface* surface, int left, int top, int right, int bottom, uint32_t color);
+
+// Composite a premultiplied color over a rectangle of the surface using the
+// coverage stored in the green channel of the mask (e.g. antialiased text
+// drawn white on black by GDI). Mask and surface share coordinates.
+void ArgbBlendCoverage(ArgbSurface* surface, const ArgbSurface* mask,
+                       int left, int top, int right, int bottom, uint32_t color);
+
+// Cut antialiased rounded corners into the surface and draw a border of the
+// given width along the rounded outline. Only the edge band is touched.
+void ArgbRoundCorners(ArgbSurface* surface, float radius, float borderWidth, uint32_t borderColor);
+
+#endif // ARGB_H
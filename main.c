@@ -3,14 +3,20 @@
 #endif 
 
 #include <windows.h>
+#include <winternl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "argb.h"
+#include "trigram.h"
 
 // Structure to hold window information for the tabs controller
 typedef struct {
     HWND hwnd;
     wchar_t title[256];
     wchar_t className[256];
+    DWORD processId;    // Owning process, for the resource columns
 } WindowInfo;
 
 // Global variables for tabs controller
@@ -22,22 +28,281 @@ static HWND g_mainHwnd = NULL;
 static BOOL g_orderInitialized = FALSE;
 static HWND g_previouslyFocusedWindow = NULL; // Store the window that was focused before showing overlay
 
+// Pre-rendered overlay surface, kept up to date while the overlay is hidden so
+// the hotkey only has to present it. The frame is premultiplied ARGB and is
+// presented with UpdateLayeredWindow; text is rasterized by GDI into a
+// separate coverage mask and composited with the argb.c kernels.
+static HDC g_overlayDC = NULL;
+static HBITMAP g_overlayBitmap = NULL;
+static HBITMAP g_overlayOldBitmap = NULL;
+static ArgbSurface g_overlaySurface = {NULL, 0, 0, 0};
+static HDC g_textDC = NULL;
+static HBITMAP g_textBitmap = NULL;
+static HBITMAP g_textOldBitmap = NULL;
+static HFONT g_overlayFont = NULL;
+static HFONT g_textOldFont = NULL;
+static ArgbSurface g_textMask = {NULL, 0, 0, 0};
+static int g_overlayX = 0;
+static int g_overlayY = 0;
+static int g_overlayWidth = 0;
+static int g_overlayHeight = 0;
+static BOOL g_overlayDirty = TRUE;     // Back buffer no longer matches the current state
+static BOOL g_windowListDirty = TRUE;  // Window set or titles changed since the last refresh
+static BOOL g_refreshPending = FALSE;  // Refresh timer is armed and will fire
+static HWINEVENTHOOK g_objectHook = NULL;
+static HWINEVENTHOOK g_nameChangeHook = NULL;
+static HWINEVENTHOOK g_foregroundHook = NULL;
+static HWINEVENTHOOK g_minimizeHook = NULL;
+static LARGE_INTEGER g_hotkeyTime;     // When the last Shift+Tab arrived, for latency logging
+static BOOL g_forceColdOverlay = FALSE; // --cold-overlay: every show enumerates and renders first
+
+// Workspace snapshot file layout: a SnapshotHeader followed by `count`
+// SnapshotEntry records, each followed by its class name, title and
+// executable name as UTF-16 without terminators
+#define SNAPSHOT_MAGIC 0x5357574D      // "MWWS" little-endian
+#define SNAPSHOT_VERSION 1
+#define BENCH_RESTORE_WINDOWS 150      // Default window count for --bench-restore
+#define BENCH_RESTORE_ROUNDS 5
+
+typedef struct {
+    UINT32 magic;
+    UINT32 version;
+    UINT32 count;
+} SnapshotHeader;
+
+typedef struct {
+    UINT32 showCmd;        // SW_SHOWNORMAL, SW_SHOWMINIMIZED or SW_SHOWMAXIMIZED
+    UINT32 flags;          // WINDOWPLACEMENT flags, e.g. WPF_RESTORETOMAXIMIZED
+    RECT normalRect;       // Restored placement, workspace coordinates
+    RECT windowRect;       // Screen rectangle at capture time
+    RECT monitorRect;      // Monitor the window was on
+    UINT16 classLength;
+    UINT16 titleLength;
+    UINT16 exeLength;
+    UINT16 reserved;
+} SnapshotEntry;
+
+// A snapshot entry loaded for matching against live windows
+typedef struct {
+    SnapshotEntry entry;
+    wchar_t className[256];
+    wchar_t title[256];
+    wchar_t exeName[MAX_PATH];
+    BOOL matched;
+} SnapshotItem;
+
+// Per-process resource usage from one system-wide sampling pass
+typedef struct {
+    DWORD processId;
+    ULONGLONG createTime;      // Tells a reused process ID apart from the old process
+    ULONGLONG cpuTime;         // Kernel + user time, 100ns units
+    SIZE_T workingSet;         // Bytes
+    int cpuTenths;             // CPU% * 10 since the previous sample, -1 if unknown
+} ProcessSample;
+
+// Layout of a SystemProcessInformation record as returned by ntdll.
+// winternl.h only publishes a version with most fields reserved
+typedef struct {
+    ULONG NextEntryOffset;
+    ULONG NumberOfThreads;
+    LARGE_INTEGER WorkingSetPrivateSize;
+    ULONG HardFaultCount;
+    ULONG NumberOfThreadsHighWatermark;
+    ULONGLONG CycleTime;
+    LARGE_INTEGER CreateTime;
+    LARGE_INTEGER UserTime;
+    LARGE_INTEGER KernelTime;
+    UNICODE_STRING ImageName;
+    LONG BasePriority;
+    HANDLE UniqueProcessId;
+    HANDLE InheritedFromUniqueProcessId;
+    ULONG HandleCount;
+    ULONG SessionId;
+    ULONG_PTR UniqueProcessKey;
+    SIZE_T PeakVirtualSize;
+    SIZE_T VirtualSize;
+    ULONG PageFaultCount;
+    SIZE_T PeakWorkingSetSize;
+    SIZE_T WorkingSetSize;
+} SystemProcessEntry;
+
+typedef NTSTATUS (WINAPI *NtQuerySystemInformationFn)(ULONG, PVOID, ULONG, PULONG);
+
+// Resource sampler state. Samples are kept sorted by process ID; the
+// previous pass is kept so CPU can be computed as a delta
+static NtQuerySystemInformationFn g_ntQuerySystemInformation = NULL;
+static BYTE* g_processInfoBuffer = NULL;
+static ULONG g_processInfoSize = 0;
+static ProcessSample* g_samples = NULL;
+static ProcessSample* g_previousSamples = NULL;
+static int g_sampleCount = 0;
+static int g_previousSampleCount = 0;
+static int g_sampleCapacity = 0;
+static LONGLONG g_sampleTime = 0;           // QueryPerformanceCounter ticks
+static LONGLONG g_previousSampleTime = 0;
+static BOOL g_sampling = FALSE;             // Only while the overlay is visible
+
+// History of window titles, including windows that have since closed.
+// Bounded, persisted to winmanager_history.bin (a HistoryHeader followed by
+// HistoryRecord + UTF-16 title per entry) and searchable via a trigram index
+typedef struct {
+    HWND hwnd;               // Window that last showed this title, NULL if unknown
+    ULONGLONG firstSeen;     // FILETIME, 100ns units
+    ULONGLONG lastSeen;
+    wchar_t* title;
+} HistoryEntry;
+
+typedef struct {
+    UINT32 magic;
+    UINT32 version;
+    UINT32 count;
+} HistoryHeader;
+
+typedef struct {
+    UINT64 firstSeen;
+    UINT64 lastSeen;
+    UINT32 titleLength;
+    UINT32 reserved;
+} HistoryRecord;
+
+static HistoryEntry* g_history = NULL;
+static int g_historyCount = 0;
+static int g_historyCapacity = 0;
+static int* g_historySlots = NULL;     // Title hash table of entry indexes, -1 is empty
+static int g_historySlotCount = 0;     // Power of two
+static TrigramIndex g_historyIndex;    // Document IDs are entry indexes
+static BOOL g_historyMode = FALSE;     // Overlay shows history search instead of the list
+static wchar_t g_historyQuery[128];
+static int* g_historyResults = NULL;   // Matching entry indexes, most recently seen first
+static int g_historyResultCount = 0;
+static int g_historySelected = 0;
+static LONGLONG g_historyQueryMicros = 0;
+static BOOL g_historyDirty = FALSE;    // Changed since the last SaveHistory
+
+#define HISTORY_MAGIC 0x5448574D       // "MWHT" little-endian
+#define HISTORY_VERSION 1
+#define HISTORY_MAX_ENTRIES 50000      // Oldest quarter is dropped when full
+#define HISTORY_MAX_RESULTS 500
+#define HISTORY_VISIBLE_ROWS 15
+
+// Window activation strategies, in the order they are tried. Foreground
+// locks make the cheap ones fail silently, so each attempt is confirmed
+// against the real foreground window before escalating
+typedef enum {
+    ACTIVATE_DIRECT,            // SetForegroundWindow, allowed while we own the foreground
+    ACTIVATE_SYNTHETIC_INPUT,   // A synthetic input event lifts the foreground lock
+    ACTIVATE_ATTACH_INPUT,      // Share input state with the foreground thread
+    ACTIVATE_MINIMIZE_RESTORE,  // Last resort: minimize and restore the target
+    ACTIVATE_STRATEGY_COUNT
+} ActivationStrategy;
+
+// Per-strategy results, accumulated across runs in winmanager_activation.txt
+typedef struct {
+    const char* name;
+    int attempts;
+    int successes;
+    LONGLONG totalMicros;       // Time spent in the strategy, including confirmation
+    LONGLONG successMicros;     // Same, successful attempts only
+} ActivationStats;
+
+static ActivationStats g_activationStats[ACTIVATE_STRATEGY_COUNT] = {
+    {"direct"}, {"synthetic-input"}, {"attach-input"}, {"minimize-restore"}
+};
+
+#define ACTIVATION_BUDGET_MS 300       // Give up on a window after this long
+#define ACTIVATION_CONFIRM_MS 50       // How long one strategy may take to show effect
+static BOOL g_activationStatsDirty = FALSE;
+
+#define TIMER_REFRESH_OVERLAY 1
+#define TIMER_SAMPLE_RESOURCES 2
+#define TIMER_SAVE_STATE 3
+#define REFRESH_DELAY_MS 100           // Coalesces bursts of window events into one refresh
+#define RESOURCE_SAMPLE_INTERVAL_MS 1000
+#define RESOURCE_STALE_MS 3000         // Older samples are not shown, or used as a CPU baseline
+#define SAVE_INTERVAL_MS (5 * 60 * 1000)  // Checkpoint, so a crash or kill loses little
+#define SYSTEM_PROCESS_INFORMATION_CLASS 5
+#ifndef STATUS_INFO_LENGTH_MISMATCH
+#define STATUS_INFO_LENGTH_MISMATCH ((NTSTATUS)0xC0000004L)
+#endif
+
 // Function declarations
 LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam);
 BOOL CALLBACK EnumWindowsProc(HWND hwnd, LPARAM lParam);
+void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject,
+                           LONG idChild, DWORD idEventThread, DWORD dwmsEventTime);
 void ShowTabsOverlay(HWND hwnd);
 void HideTabsOverlay(HWND hwnd);
-void DrawTabsList(HDC hdc, RECT* rect);
+void DrawTabsList(HDC textDC, ArgbSurface* surface, ArgbSurface* textMask);
+void DrawTextLayer(HDC textDC, ArgbSurface* surface, ArgbSurface* textMask,
+                   const wchar_t* text, RECT* rect, UINT format, COLORREF color);
+uint32_t ToArgb(COLORREF color, BYTE alpha);
+void LayoutOverlay(HWND hwnd);
+void RenderOverlay(HWND hwnd);
+void PresentOverlay(HWND hwnd);
+HBITMAP CreateArgbBitmap(HDC dc, int width, int height, uint32_t** pixels);
+void StartResourceSampling(HWND hwnd);
+void StopResourceSampling(HWND hwnd);
+BOOL SampleProcesses();
+const ProcessSample* FindProcessSample(DWORD processId);
+int CompareProcessSamples(const void* a, const void* b);
+void RefreshOverlay(HWND hwnd);
+void RefreshWindowList(HWND hwnd);
+void ScheduleOverlayRefresh(HWND hwnd);
+void DestroyOverlaySurface();
 void FocusSelectedWindow();
+BOOL FocusWindow(HWND targetHwnd);
+void TryActivation(ActivationStrategy strategy, HWND targetHwnd);
+BOOL IsForegroundTarget(HWND targetHwnd);
+BOOL WaitForForeground(HWND targetHwnd, LONGLONG deadline);
+void SaveActivationStats();
+void LoadActivationStats();
 void SwapWindows(int index1, int index2);
 void UpdateWindowList();
 void SaveWindowOrder();
 void LoadWindowOrder();
 int FindWindowInList(HWND hwnd);
+BOOL SaveWorkspaceSnapshot(const wchar_t* name);
+int RestoreWorkspaceSnapshot(const wchar_t* name);
+void GetSnapshotPath(const wchar_t* name, wchar_t* path, int size);
+void GetWindowExeName(HWND hwnd, wchar_t* exeName, DWORD size);
+WindowInfo* CollectSnapshotWindows(int* count);
+void RunRestoreBenchmark(HINSTANCE hInstance, int count);
+void PumpPendingMessages();
+BOOL ReadSnapshotString(const BYTE** cursor, const BYTE* end, int length, wchar_t* out, int size);
 BOOL IsValidWindow(HWND hwnd);
+BOOL IsApplicationWindow(HWND hwnd, BOOL includeMinimized);
+BOOL GetFilterRect(HWND hwnd, BOOL includeMinimized, RECT* rect);
+void LoadHistory();
+void SaveHistory();
+void RecordWindowHistory(HWND hwnd, const wchar_t* title);
+BOOL IsHistoryEntryLive(const HistoryEntry* entry);
+BOOL AddHistoryEntry(HWND hwnd, const wchar_t* title, ULONGLONG firstSeen, ULONGLONG lastSeen);
+int FindHistorySlot(const wchar_t* title);
+UINT32 HashTitle(const wchar_t* title);
+BOOL RehashHistorySlots();
+BOOL RebuildHistoryLookup();
+void EvictHistory();
+void RunHistoryQuery();
+int CompareHistoryRecency(const void* a, const void* b);
+void EnterHistoryMode(HWND hwnd);
+void LeaveHistoryMode(HWND hwnd);
+void DrawHistoryList(HDC textDC, ArgbSurface* surface, ArgbSurface* textMask);
 
 int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR pCmdLine, int nCmdShow)
 {
+    // Debug mode: time snapshot restore over throwaway windows, then exit
+    if (pCmdLine && strncmp(pCmdLine, "--bench-restore", 15) == 0) {
+        int count = atoi(pCmdLine + 15);
+        RunRestoreBenchmark(hInstance, count > 0 ? count : BENCH_RESTORE_WINDOWS);
+        return 0;
+    }
+
+    // Debug mode: skip the pre-rendered frame so hotkey latency can be
+    // compared against the enumerate-and-paint-on-show behaviour
+    if (pCmdLine && strstr(pCmdLine, "--cold-overlay")) {
+        g_forceColdOverlay = TRUE;
+    }
+
     // Register the window class.
     const wchar_t CLASS_NAME[]  = L"TabsController";
     
@@ -74,8 +339,28 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR pCmdLine,
 
     g_mainHwnd = hwnd;
 
-    // Load previously saved window order
+    // Load previously saved window order and title history
     LoadWindowOrder();
+    LoadHistory();
+    LoadActivationStats();
+
+    // Build the first frame now so the first Shift+Tab is already warm
+    RefreshWindowList(hwnd);
+
+    // Track window creation, destruction, visibility, title, minimize and
+    // foreground changes so the hidden overlay can be updated incrementally
+    g_objectHook = SetWinEventHook(EVENT_OBJECT_CREATE, EVENT_OBJECT_HIDE, NULL,
+                                   WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    g_nameChangeHook = SetWinEventHook(EVENT_OBJECT_NAMECHANGE, EVENT_OBJECT_NAMECHANGE, NULL,
+                                       WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    g_foregroundHook = SetWinEventHook(EVENT_SYSTEM_FOREGROUND, EVENT_SYSTEM_FOREGROUND, NULL,
+                                       WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+    g_minimizeHook = SetWinEventHook(EVENT_SYSTEM_MINIMIZESTART, EVENT_SYSTEM_MINIMIZEEND, NULL,
+                                     WinEventProc, 0, 0, WINEVENT_OUTOFCONTEXT | WINEVENT_SKIPOWNPROCESS);
+
+    // Persist the history and activation stats periodically, not only on a
+    // clean exit
+    SetTimer(hwnd, TIMER_SAVE_STATE, SAVE_INTERVAL_MS, NULL);
 
     // Register global hotkey: Shift + Tab (VK_TAB with MOD_SHIFT)
     if (!RegisterHotKey(hwnd, 1, MOD_SHIFT, VK_TAB))
@@ -96,6 +381,23 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR pCmdLine,
 
     // Cleanup
     SaveWindowOrder();
+    SaveHistory();
+    SaveActivationStats();
+    for (int i = 0; i < g_historyCount; i++) {
+        free(g_history[i].title);
+    }
+    free(g_history);
+    free(g_historySlots);
+    free(g_historyResults);
+    TrigramIndexFree(&g_historyIndex);
+    free(g_processInfoBuffer);
+    free(g_samples);
+    free(g_previousSamples);
+    if (g_objectHook) UnhookWinEvent(g_objectHook);
+    if (g_nameChangeHook) UnhookWinEvent(g_nameChangeHook);
+    if (g_foregroundHook) UnhookWinEvent(g_foregroundHook);
+    if (g_minimizeHook) UnhookWinEvent(g_minimizeHook);
+    DestroyOverlaySurface();
     if (g_windows) {
         free(g_windows);
     }
@@ -112,9 +414,20 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
         PostQuitMessage(0);
         return 0;
 
+    case WM_ENDSESSION:
+        // Logoff or shutdown ends the process without leaving the message
+        // loop, so the cleanup in WinMain never runs
+        if (wParam) {
+            SaveWindowOrder();
+            SaveHistory();
+            SaveActivationStats();
+        }
+        return 0;
+
     case WM_HOTKEY:
         // Handle Shift+Tab hotkey press
         if (wParam == 1) {
+            QueryPerformanceCounter(&g_hotkeyTime);
             if (!g_showingTabs) {
                 ShowTabsOverlay(hwnd);
             } else {
@@ -124,6 +437,49 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
         return 0;
 
     case WM_KEYDOWN:
+        if (g_showingTabs && g_historyMode) {
+            switch (wParam) {
+            case VK_UP:
+                if (g_historySelected > 0) {
+                    g_historySelected--;
+                    RefreshOverlay(hwnd);
+                }
+                return 0;
+            case VK_DOWN:
+                if (g_historySelected < g_historyResultCount - 1) {
+                    g_historySelected++;
+                    RefreshOverlay(hwnd);
+                }
+                return 0;
+            case VK_RETURN:
+                // Jump to the result if its window still shows that title
+                if (g_historySelected < g_historyResultCount) {
+                    const HistoryEntry* entry = &g_history[g_historyResults[g_historySelected]];
+                    if (IsHistoryEntryLive(entry)) {
+                        FocusWindow(entry->hwnd);
+                        HideTabsOverlay(hwnd);
+                    } else {
+                        MessageBeep(MB_OK);
+                    }
+                }
+                return 0;
+            case VK_BACK:
+                {
+                    size_t length = wcslen(g_historyQuery);
+                    if (length > 0) {
+                        g_historyQuery[length - 1] = L'\0';
+                        RunHistoryQuery();
+                        RefreshOverlay(hwnd);
+                    }
+                }
+                return 0;
+            case VK_ESCAPE:
+                // Back to the window list
+                LeaveHistoryMode(hwnd);
+                return 0;
+            }
+            break; // Typed characters arrive as WM_CHAR
+        }
         if (g_showingTabs) {
             // Check if Ctrl key is pressed
             BOOL ctrlPressed = GetKeyState(VK_CONTROL) & 0x8000;
@@ -144,13 +500,13 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     if (g_selectedIndex > 0) {
                         SwapWindows(g_selectedIndex, g_selectedIndex - 1);
                         g_selectedIndex--;
-                        InvalidateRect(hwnd, NULL, TRUE);
+                        RefreshOverlay(hwnd);
                     }
                 } else {
                     // Navigate up in the list
                     if (g_selectedIndex > 0) {
                         g_selectedIndex--;
-                        InvalidateRect(hwnd, NULL, TRUE);
+                        RefreshOverlay(hwnd);
                     }
                 }
                 return 0;
@@ -160,13 +516,13 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                     if (g_selectedIndex < g_windowCount - 1) {
                         SwapWindows(g_selectedIndex, g_selectedIndex + 1);
                         g_selectedIndex++;
-                        InvalidateRect(hwnd, NULL, TRUE);
+                        RefreshOverlay(hwnd);
                     }
                 } else {
                     // Navigate down in the list
                     if (g_selectedIndex < g_windowCount - 1) {
                         g_selectedIndex++;
-                        InvalidateRect(hwnd, NULL, TRUE);
+                        RefreshOverlay(hwnd);
                     }
                 }
                 return 0;
@@ -179,10 +535,29 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
                 // Hide the overlay without selecting
                 HideTabsOverlay(hwnd);
                 return 0;
+            case 'F':
+                // Ctrl+F searches the history of window titles
+                if (ctrlPressed) {
+                    EnterHistoryMode(hwnd);
+                }
+                return 0;
             // Handle number keys 1-9 for direct window selection
             case '1': case '2': case '3': case '4': case '5':
             case '6': case '7': case '8': case '9':
-                {
+                if (ctrlPressed) {
+                    // Ctrl+Shift+N saves workspace snapshot N, Ctrl+N restores it
+                    wchar_t snapshotName[8];
+                    wsprintfW(snapshotName, L"%c", (wchar_t)wParam);
+                    HideTabsOverlay(hwnd);
+                    if (GetKeyState(VK_SHIFT) & 0x8000) {
+                        SaveWorkspaceSnapshot(snapshotName);
+                    } else {
+                        RestoreWorkspaceSnapshot(snapshotName);
+                    }
+                    // Both re-enumerate windows, bring the hidden frame up to date
+                    g_windowListDirty = TRUE;
+                    ScheduleOverlayRefresh(hwnd);
+                } else {
                     int windowIndex = wParam - '1'; // Convert '1' to 0, '2' to 1, etc.
                     if (windowIndex >= 0 && windowIndex < g_windowCount) {
                         g_selectedIndex = windowIndex;
@@ -195,22 +570,60 @@ LRESULT CALLBACK WindowProc(HWND hwnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
         }
         break;
 
-    case WM_PAINT:
-        {
-            PAINTSTRUCT ps;
-            HDC hdc = BeginPaint(hwnd, &ps);
+    case WM_CHAR:
+        // Build the history search query
+        if (g_showingTabs && g_historyMode && wParam >= 0x20) {
+            size_t length = wcslen(g_historyQuery);
+            if (length + 1 < sizeof(g_historyQuery) / sizeof(g_historyQuery[0])) {
+                g_historyQuery[length] = (wchar_t)wParam;
+                g_historyQuery[length + 1] = L'\0';
+                RunHistoryQuery();
+                RefreshOverlay(hwnd);
+            }
+            return 0;
+        }
+        break;
 
+    case WM_TIMER:
+        if (wParam == TIMER_REFRESH_OVERLAY) {
+            KillTimer(hwnd, TIMER_REFRESH_OVERLAY);
+            g_refreshPending = FALSE;
             if (g_showingTabs) {
-                DrawTabsList(hdc, &ps.rcPaint);
-            } else {
-                // Fill with background color when not showing tabs
-                FillRect(hdc, &ps.rcPaint, (HBRUSH)(COLOR_WINDOW+1));
+                // Keep the list stable while the user is navigating it,
+                // HideTabsOverlay picks up the pending change
+                return 0;
+            }
+            if (g_windowListDirty) {
+                RefreshWindowList(hwnd);
+            } else if (g_overlayDirty) {
+                RenderOverlay(hwnd);
+            }
+        } else if (wParam == TIMER_SAMPLE_RESOURCES) {
+            if (!g_showingTabs) {
+                StopResourceSampling(hwnd);
+                return 0;
+            }
+            // The first tick comes right after showing, then settle on the interval
+            SetTimer(hwnd, TIMER_SAMPLE_RESOURCES, RESOURCE_SAMPLE_INTERVAL_MS, NULL);
+            if (SampleProcesses()) {
+                RefreshOverlay(hwnd);
+            }
+        } else if (wParam == TIMER_SAVE_STATE) {
+            if (g_historyDirty) {
+                SaveHistory();
+            }
+            if (g_activationStatsDirty) {
+                SaveActivationStats();
             }
-
-            EndPaint(hwnd, &ps);
         }
         return 0;
 
+    case WM_DISPLAYCHANGE:
+        // Screen size changed, re-center the pre-rendered overlay
+        g_windowListDirty = TRUE;
+        ScheduleOverlayRefresh(hwnd);
+        break;
+
     case WM_ACTIVATE:
         // Hide tabs overlay if window loses focus
         if (LOWORD(wParam) == WA_INACTIVE && g_showingTabs) {
@@ -241,15 +654,92 @@ BOOL CALLBACK EnumWindowsProc(HWND hwnd, LPARAM lParam)
     // Get window class name
     GetClassNameW(hwnd, g_windows[g_windowCount].className, 256);
     
-    // Store window handle
+    // Store window handle and owning process
     g_windows[g_windowCount].hwnd = hwnd;
+    GetWindowThreadProcessId(hwnd, &g_windows[g_windowCount].processId);
     
     g_windowCount++;
     return TRUE; // Continue enumeration
 }
 
+// Receives window events while the overlay is hidden and marks the
+// pre-rendered frame stale; the actual refresh is coalesced on a timer
+void CALLBACK WinEventProc(HWINEVENTHOOK hook, DWORD event, HWND hwnd, LONG idObject,
+                           LONG idChild, DWORD idEventThread, DWORD dwmsEventTime)
+{
+    // Only top-level window events matter, not carets, controls or menus
+    if (idObject != OBJID_WINDOW || idChild != CHILDID_SELF || hwnd == NULL) return;
+    if (hwnd == g_mainHwnd) return;
+
+    if (event == EVENT_SYSTEM_FOREGROUND) {
+        // Remember the focused window so the frame highlights it before the
+        // hotkey. Also re-enumerate: moves and resizes fire no event we hook
+        // but can take a window in or out of IsValidWindow's size checks
+        if (!g_showingTabs && hwnd != g_previouslyFocusedWindow) {
+            g_previouslyFocusedWindow = hwnd;
+            g_overlayDirty = TRUE;
+            g_windowListDirty = TRUE;
+            ScheduleOverlayRefresh(g_mainHwnd);
+        }
+        return;
+    }
+
+    if (GetAncestor(hwnd, GA_ROOT) != hwnd) return;
+
+    if (event == EVENT_OBJECT_HIDE || event == EVENT_OBJECT_DESTROY) {
+        // Removals only matter for windows we are listing
+        if (FindWindowInList(hwnd) < 0) return;
+    } else if (event == EVENT_OBJECT_NAMECHANGE) {
+        // A listed window changed title, or an untitled window (often shown
+        // before it is titled, e.g. Chrome and Electron) just became listable
+        if (FindWindowInList(hwnd) < 0 && !IsValidWindow(hwnd)) return;
+    } else if (event == EVENT_OBJECT_CREATE || event == EVENT_OBJECT_SHOW) {
+        // Tooltips, menus and popups come and go constantly; only windows we
+        // would list are worth a refresh. A window created hidden is picked
+        // up by its SHOW or NAMECHANGE instead
+        if (!IsValidWindow(hwnd)) return;
+    }
+    // Minimize and restore always count: minimized windows sit at -32000 and
+    // drop out of the list, restored ones come back. The events are
+    // asynchronous, so the window may not be in its new state yet to check
+
+    g_windowListDirty = TRUE;
+    ScheduleOverlayRefresh(g_mainHwnd);
+}
+
+// Arm the refresh timer unless it already is. Events arriving while it is
+// armed fold into that refresh, so a steady stream of events cannot keep
+// pushing it back beyond REFRESH_DELAY_MS
+void ScheduleOverlayRefresh(HWND hwnd)
+{
+    if (g_refreshPending) return;
+    g_refreshPending = TRUE;
+    SetTimer(hwnd, TIMER_REFRESH_OVERLAY, REFRESH_DELAY_MS, NULL);
+}
+
 // Check if a window is a valid application window to display in tabs
 BOOL IsValidWindow(HWND hwnd)
+{
+    return IsApplicationWindow(hwnd, FALSE);
+}
+
+// The rect the size and position filters look at. Minimized windows sit at
+// -32000, so when they are wanted their restored rect is used instead
+BOOL GetFilterRect(HWND hwnd, BOOL includeMinimized, RECT* rect)
+{
+    if (includeMinimized && IsIconic(hwnd)) {
+        WINDOWPLACEMENT placement = { };
+        placement.length = sizeof(WINDOWPLACEMENT);
+        if (!GetWindowPlacement(hwnd, &placement)) return FALSE;
+        *rect = placement.rcNormalPosition;
+        return TRUE;
+    }
+    return GetWindowRect(hwnd, rect);
+}
+
+// Shared filter for application windows. The tab list leaves minimized
+// windows out; workspace snapshots include them
+BOOL IsApplicationWindow(HWND hwnd, BOOL includeMinimized)
 {
     if (!IsWindowVisible(hwnd)) return FALSE;
     if (hwnd == g_mainHwnd) return FALSE; // Don't include our own window
@@ -360,7 +850,7 @@ BOOL IsValidWindow(HWND hwnd)
         }
         // For other tool windows, check if they're reasonably sized applications
         RECT rect;
-        if (GetWindowRect(hwnd, &rect)) {
+        if (GetFilterRect(hwnd, includeMinimized, &rect)) {
             int width = rect.right - rect.left;
             int height = rect.bottom - rect.top;
             // Allow larger tool windows (they might be legitimate apps)
@@ -382,7 +872,7 @@ BOOL IsValidWindow(HWND hwnd)
         // Exception: Some applications like Steam might not have standard captions
         // but still be valid applications. Check if it has a reasonable size.
         RECT rect;
-        if (GetWindowRect(hwnd, &rect)) {
+        if (GetFilterRect(hwnd, includeMinimized, &rect)) {
             int width = rect.right - rect.left;
             int height = rect.bottom - rect.top;
             if (width < 200 || height < 100) {
@@ -395,7 +885,7 @@ BOOL IsValidWindow(HWND hwnd)
     
     // Filter out windows that are likely system overlays (very small or positioned off-screen)
     RECT rect;
-    if (GetWindowRect(hwnd, &rect)) {
+    if (GetFilterRect(hwnd, includeMinimized, &rect)) {
         int width = rect.right - rect.left;
         int height = rect.bottom - rect.top;
         
@@ -412,24 +902,98 @@ BOOL IsValidWindow(HWND hwnd)
 // Show the tabs overlay with list of applications
 void ShowTabsOverlay(HWND hwnd)
 {
-    // Store the currently focused window before showing our overlay
-    g_previouslyFocusedWindow = GetForegroundWindow();
-    
-    g_selectedIndex = 0;
+    // Store the currently focused window before showing our overlay.
+    // The foreground hook normally has this already, so the frame is current
+    HWND foreground = GetForegroundWindow();
+    if (foreground != hwnd && foreground != g_previouslyFocusedWindow) {
+        g_previouslyFocusedWindow = foreground;
+        g_overlayDirty = TRUE;
+    }
 
-    // Update window list while preserving custom order
-    UpdateWindowList();
+    if (g_selectedIndex != 0) {
+        g_selectedIndex = 0;
+        g_overlayDirty = TRUE;
+    }
+
+    // Slow path: a window change is still waiting on the refresh timer.
+    // It enumerates and renders before showing, as every show did before
+    // the frame was pre-rendered, so it doubles as the baseline for the
+    // latency log; --cold-overlay forces it on every show
+    if (g_forceColdOverlay) {
+        g_windowListDirty = TRUE;
+    }
+    BOOL warm = !g_windowListDirty && g_overlayDC != NULL;
+    if (g_windowListDirty || !g_overlayDC) {
+        KillTimer(hwnd, TIMER_REFRESH_OVERLAY);
+        g_refreshPending = FALSE;
+        RefreshWindowList(hwnd);
+    }
 
     if (g_windowCount == 0) {
         MessageBox(NULL, L"No windows found", L"Info", MB_OK);
         return; // No windows to show
     }
 
+    if (g_overlayDirty) {
+        RenderOverlay(hwnd);
+    }
+
+    // The frame is already presented to the hidden window, only show it
+    SetWindowPos(hwnd, HWND_TOPMOST, 0, 0, 0, 0,
+                 SWP_NOMOVE | SWP_NOSIZE | SWP_SHOWWINDOW | SWP_NOACTIVATE);
+    
+    g_showingTabs = TRUE;
+    
+    // Force focus to our window for keyboard input
+    SetForegroundWindow(hwnd);
+    SetActiveWindow(hwnd);
+    SetFocus(hwnd);
+
+    // Resource columns fill in right after the frame is on screen
+    StartResourceSampling(hwnd);
+    
+    // Log hotkey-to-visible latency (view with DebugView or a debugger)
+    LARGE_INTEGER now, frequency;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    LONGLONG micros = (now.QuadPart - g_hotkeyTime.QuadPart) * 1000000 / frequency.QuadPart;
+    wchar_t latencyMsg[100];
+    wsprintfW(latencyMsg, L"WinManager: hotkey-to-visible %d.%03d ms (%s)\n",
+              (int)(micros / 1000), (int)(micros % 1000), warm ? L"warm" : L"cold");
+    OutputDebugStringW(latencyMsg);
+}
+
+// Hide the tabs overlay
+void HideTabsOverlay(HWND hwnd)
+{
+    g_showingTabs = FALSE;
+    ShowWindow(hwnd, SW_HIDE);
+    StopResourceSampling(hwnd);
+    if (g_historyMode) {
+        LeaveHistoryMode(hwnd);
+    }
+
+    // Get the next frame ready: reset selection and catch up on any
+    // window changes that arrived while the list was on screen
+    if (g_selectedIndex != 0) {
+        g_selectedIndex = 0;
+        g_overlayDirty = TRUE;
+    }
+    if (g_windowListDirty || g_overlayDirty) {
+        ScheduleOverlayRefresh(hwnd);
+    }
+}
+
+// Compute overlay size and position for the current window count and resize
+// the hidden window and back buffer to match
+void LayoutOverlay(HWND hwnd)
+{
     // Calculate window size based on number of items
     int itemHeight = 30;
     int padding = 20;
     int width = 600;
-    int height = (g_windowCount * itemHeight) + (padding * 2);
+    int rowCount = g_historyMode ? HISTORY_VISIBLE_ROWS : g_windowCount;
+    int height = (rowCount * itemHeight) + (padding * 2);
     
     // Limit height to screen size
     int screenHeight = GetSystemMetrics(SM_CYSCREEN);
@@ -442,58 +1006,186 @@ void ShowTabsOverlay(HWND hwnd)
     int x = (screenWidth - width) / 2;
     int y = (screenHeight - height) / 2;
 
-    // Resize and position the window
-    SetWindowPos(hwnd, HWND_TOPMOST, x, y, width, height, SWP_SHOWWINDOW | SWP_NOACTIVATE);
-    
-    // Set transparency: 220 out of 255 (about 86% opacity, 14% transparent)
-    SetLayeredWindowAttributes(hwnd, 0, 220, LWA_ALPHA);
-    
-    g_showingTabs = TRUE;
-    
-    // Force focus to our window for keyboard input
-    SetForegroundWindow(hwnd);
-    SetActiveWindow(hwnd);
-    SetFocus(hwnd);
-    
-    InvalidateRect(hwnd, NULL, TRUE);
-    UpdateWindow(hwnd);
+    if (x != g_overlayX || y != g_overlayY) {
+        // The new position is applied by the next UpdateLayeredWindow
+        g_overlayX = x;
+        g_overlayY = y;
+        g_overlayDirty = TRUE;
+    }
+
+    if (g_overlayDC && width == g_overlayWidth && height == g_overlayHeight) {
+        return; // Back buffer still fits
+    }
+
+    // (Re)create the frame and text mask at the new size
+    HDC screenDC = GetDC(NULL);
+    if (!g_overlayDC) {
+        g_overlayDC = CreateCompatibleDC(screenDC);
+        g_textDC = CreateCompatibleDC(screenDC);
+    }
+    ReleaseDC(NULL, screenDC);
+    if (!g_overlayDC || !g_textDC) return;
+
+    uint32_t* framePixels = NULL;
+    uint32_t* textPixels = NULL;
+    HBITMAP frameBitmap = CreateArgbBitmap(g_overlayDC, width, height, &framePixels);
+    HBITMAP textBitmap = CreateArgbBitmap(g_textDC, width, height, &textPixels);
+    if (!frameBitmap || !textBitmap) {
+        if (frameBitmap) DeleteObject(frameBitmap);
+        if (textBitmap) DeleteObject(textBitmap);
+        return;
+    }
+
+    HBITMAP previous = (HBITMAP)SelectObject(g_overlayDC, frameBitmap);
+    if (g_overlayBitmap) {
+        DeleteObject(g_overlayBitmap);
+    } else {
+        g_overlayOldBitmap = previous;
+    }
+    previous = (HBITMAP)SelectObject(g_textDC, textBitmap);
+    if (g_textBitmap) {
+        DeleteObject(g_textBitmap);
+    } else {
+        g_textOldBitmap = previous;
+    }
+    g_overlayBitmap = frameBitmap;
+    g_textBitmap = textBitmap;
+
+    // The text DC keeps its font and colors for the life of the overlay.
+    // Grayscale antialiasing keeps the coverage mask color-neutral
+    if (!g_overlayFont) {
+        g_overlayFont = CreateFont(18, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
+                                   DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
+                                   ANTIALIASED_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
+        g_textOldFont = (HFONT)SelectObject(g_textDC, g_overlayFont);
+        SetBkMode(g_textDC, TRANSPARENT);
+        SetTextColor(g_textDC, RGB(255, 255, 255));
+    }
+
+    g_overlaySurface.pixels = framePixels;
+    g_overlaySurface.width = width;
+    g_overlaySurface.height = height;
+    g_overlaySurface.stride = width;
+    g_textMask = g_overlaySurface;
+    g_textMask.pixels = textPixels;
+
+    g_overlayWidth = width;
+    g_overlayHeight = height;
+    g_overlayDirty = TRUE;
 }
 
-// Hide the tabs overlay
-void HideTabsOverlay(HWND hwnd)
+// Create a top-down 32bpp DIB section and return its pixels
+HBITMAP CreateArgbBitmap(HDC dc, int width, int height, uint32_t** pixels)
 {
-    g_showingTabs = FALSE;
-    ShowWindow(hwnd, SW_HIDE);
+    BITMAPINFO info = { };
+    info.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    info.bmiHeader.biWidth = width;
+    info.bmiHeader.biHeight = -height; // Negative height means top-down rows
+    info.bmiHeader.biPlanes = 1;
+    info.bmiHeader.biBitCount = 32;
+    info.bmiHeader.biCompression = BI_RGB;
+
+    void* bits = NULL;
+    HBITMAP bitmap = CreateDIBSection(dc, &info, DIB_RGB_COLORS, &bits, NULL, 0);
+    *pixels = (uint32_t*)bits;
+    return bitmap;
+}
+
+// Draw the current state into the back buffer and hand it to the window
+void RenderOverlay(HWND hwnd)
+{
+    if (!g_overlayDC || !g_overlaySurface.pixels) return;
+
+    DrawTabsList(g_textDC, &g_overlaySurface, &g_textMask);
+    PresentOverlay(hwnd);
+    g_overlayDirty = FALSE;
+}
+
+// Present the frame with per-pixel alpha in a single layered-window update.
+// This works while the window is hidden, so showing it later costs nothing
+void PresentOverlay(HWND hwnd)
+{
+    POINT position = {g_overlayX, g_overlayY};
+    SIZE size = {g_overlayWidth, g_overlayHeight};
+    POINT source = {0, 0};
+    BLENDFUNCTION blend = {AC_SRC_OVER, 0, 255, AC_SRC_ALPHA};
+
+    UpdateLayeredWindow(hwnd, NULL, &position, &size, g_overlayDC, &source, 0, &blend, ULW_ALPHA);
+}
+
+// Re-render after a selection or order change and present the new frame
+void RefreshOverlay(HWND hwnd)
+{
+    g_overlayDirty = TRUE;
+    RenderOverlay(hwnd);
+}
+
+// Re-enumerate windows and bring the pre-rendered frame up to date
+void RefreshWindowList(HWND hwnd)
+{
+    UpdateWindowList();
+    g_windowListDirty = FALSE;
+
+    // Remember every title we see, so closed windows stay searchable
+    for (int i = 0; i < g_windowCount; i++) {
+        RecordWindowHistory(g_windows[i].hwnd, g_windows[i].title);
+    }
+
+    if (g_selectedIndex >= g_windowCount) {
+        g_selectedIndex = g_windowCount > 0 ? g_windowCount - 1 : 0;
+    }
+
+    LayoutOverlay(hwnd);
+    g_overlayDirty = TRUE;
+    RenderOverlay(hwnd);
+}
+
+// Release the back buffer, text mask and font
+void DestroyOverlaySurface()
+{
+    if (g_textDC) {
+        if (g_textOldFont) SelectObject(g_textDC, g_textOldFont);
+        if (g_textOldBitmap) SelectObject(g_textDC, g_textOldBitmap);
+        DeleteDC(g_textDC);
+    }
+    if (g_overlayDC) {
+        if (g_overlayOldBitmap) SelectObject(g_overlayDC, g_overlayOldBitmap);
+        DeleteDC(g_overlayDC);
+    }
+    if (g_textBitmap) DeleteObject(g_textBitmap);
+    if (g_overlayBitmap) DeleteObject(g_overlayBitmap);
+    if (g_overlayFont) DeleteObject(g_overlayFont);
+
+    g_textDC = NULL;
+    g_textBitmap = NULL;
+    g_textOldBitmap = NULL;
+    g_textOldFont = NULL;
+    g_overlayFont = NULL;
+    g_overlayDC = NULL;
+    g_overlayBitmap = NULL;
+    g_overlayOldBitmap = NULL;
+    g_overlaySurface.pixels = NULL;
+    g_textMask.pixels = NULL;
 }
 
 // Draw the list of tabs/applications
-void DrawTabsList(HDC hdc, RECT* rect)
+void DrawTabsList(HDC textDC, ArgbSurface* surface, ArgbSurface* textMask)
 {
+    if (g_historyMode) {
+        DrawHistoryList(textDC, surface, textMask);
+        return;
+    }
     if (!g_windows || g_windowCount == 0) return;
 
-    // Set up drawing
-    SetBkMode(hdc, TRANSPARENT);
-    HFONT hFont = CreateFont(18, 0, 0, 0, FW_NORMAL, FALSE, FALSE, FALSE,
-                            DEFAULT_CHARSET, OUT_DEFAULT_PRECIS, CLIP_DEFAULT_PRECIS,
-                            DEFAULT_QUALITY, DEFAULT_PITCH | FF_DONTCARE, L"Segoe UI");
-    HFONT hOldFont = (HFONT)SelectObject(hdc, hFont);
-
-    // Fill background with a dark gray color
-    HBRUSH hBrush = CreateSolidBrush(RGB(59, 69, 79));
-    FillRect(hdc, rect, hBrush);
-    DeleteObject(hBrush);
-
-    // Draw a subtle rounded border effect
-    HPEN hPen = CreatePen(PS_SOLID, 2, RGB(80, 80, 80));
-    HPEN hOldPen = (HPEN)SelectObject(hdc, hPen);
-    SelectObject(hdc, hPen);                        
-    // Draw rounded rectangle effect
-    RECT borderRect = *rect;
-    borderRect.left += 1;
-    borderRect.top += 1;
-    borderRect.right -= 1;
-    borderRect.bottom -= 1;
-    RoundRect(hdc, borderRect.left, borderRect.top, borderRect.right, borderRect.bottom, 10, 10);
+    RECT bounds = {0, 0, surface->width, surface->height};
+    RECT* rect = &bounds;
+
+    // Fill background with a translucent dark gray (220 of 255 opacity);
+    // highlights and text stay fully opaque
+    ArgbFillRect(surface, 0, 0, surface->width, surface->height, ToArgb(RGB(59, 69, 79), 220));
+
+    // Clear the text coverage mask
+    ArgbFillRect(textMask, 0, 0, textMask->width, textMask->height, 0);
 
     // Draw each window item
     int itemHeight = 30;
@@ -501,10 +1193,10 @@ void DrawTabsList(HDC hdc, RECT* rect)
     
     // Add debug info
     wchar_t debugText[150];
-wsprintfW(debugText, L"Found %d windows - Blue: selected, Green: active, ●: currently focused, Reorder with Ctrl+Arrows", g_windowCount);
+wsprintfW(debugText, L"Found %d windows - Blue: selected, Green: active, ●: currently focused, Reorder with Ctrl+Arrows, Ctrl+F: history", g_windowCount);
     RECT debugRect = {rect->left + 5, rect->top + 5, rect->right - 5, rect->top + 25};
-    SetTextColor(hdc, RGB(0, 0, 0));
-    DrawTextW(hdc, debugText, -1, &debugRect, DT_LEFT | DT_TOP | DT_SINGLELINE);
+    DrawTextLayer(textDC, surface, textMask, debugText, &debugRect,
+                  DT_LEFT | DT_TOP | DT_SINGLELINE, RGB(0, 0, 0));
     
     for (int i = 0; i < g_windowCount; i++) {
         RECT itemRect;
@@ -517,11 +1209,11 @@ wsprintfW(debugText, L"Found %d windows - Blue: selected, Green: active, ●: cu
         if (itemRect.top >= rect->bottom) break;
 
         // Highlight selected item
+        COLORREF textColor;
         if (i == g_selectedIndex) {
-            HBRUSH hSelBrush = CreateSolidBrush(RGB(30, 3, 200)); // Steel blue background
-            FillRect(hdc, &itemRect, hSelBrush);
-            DeleteObject(hSelBrush);
-            SetTextColor(hdc, RGB(255, 255, 255)); // White text for selected item
+            ArgbFillRect(surface, itemRect.left, itemRect.top, itemRect.right, itemRect.bottom,
+                         ToArgb(RGB(30, 3, 200), 255)); // Steel blue background
+            textColor = RGB(255, 255, 255); // White text for selected item
         } else {
             // Check if this is the currently focused window for special highlighting
             // Use the previously focused window instead of current foreground (which is our overlay)
@@ -529,12 +1221,11 @@ wsprintfW(debugText, L"Found %d windows - Blue: selected, Green: active, ●: cu
             
             if (isCurrentlyFocused) {
                 // Highlight currently focused window with a different color
-                HBRUSH hFocusBrush = CreateSolidBrush(RGB(60, 120, 60)); // Dark green background
-                FillRect(hdc, &itemRect, hFocusBrush);
-                DeleteObject(hFocusBrush);
-                SetTextColor(hdc, RGB(144, 238, 144)); // Light green text
+                ArgbFillRect(surface, itemRect.left, itemRect.top, itemRect.right, itemRect.bottom,
+                             ToArgb(RGB(60, 120, 60), 255)); // Dark green background
+                textColor = RGB(144, 238, 144); // Light green text
             } else {
-                SetTextColor(hdc, RGB(0, 0, 0)); // Light gray text for normal items
+                textColor = RGB(0, 0, 0); // Light gray text for normal items
             }
         }
 
@@ -568,15 +1259,55 @@ wsprintfW(debugText, L"Found %d windows - Blue: selected, Green: active, ●: cu
                 wsprintfW(displayText, L"    %s", g_windows[i].title);
             }
         }
-        DrawTextW(hdc, displayText, -1, &itemRect, 
-                 DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS);
+        // CPU and memory of the owning process, right-aligned, while sampling
+        const ProcessSample* sample = g_sampling ? FindProcessSample(g_windows[i].processId) : NULL;
+        if (sample) {
+            wchar_t usageText[64];
+            int megabytes = (int)(sample->workingSet / (1024 * 1024));
+            wchar_t memoryText[32];
+            if (megabytes >= 1024) {
+                wsprintfW(memoryText, L"%d.%d GB", megabytes / 1024, (megabytes % 1024) * 10 / 1024);
+            } else {
+                wsprintfW(memoryText, L"%d MB", megabytes);
+            }
+            if (sample->cpuTenths >= 0) {
+                wsprintfW(usageText, L"%d.%d%%  %s", sample->cpuTenths / 10, sample->cpuTenths % 10, memoryText);
+            } else {
+                wsprintfW(usageText, L"--%%  %s", memoryText);
+            }
+            DrawTextLayer(textDC, surface, textMask, usageText, &itemRect,
+                          DT_RIGHT | DT_VCENTER | DT_SINGLELINE, textColor);
+
+            // Keep the title clear of the usage text, whatever its width
+            RECT usageRect = {0, 0, 0, 0};
+            DrawTextW(textDC, usageText, -1, &usageRect, DT_CALCRECT | DT_SINGLELINE);
+            itemRect.right -= (usageRect.right - usageRect.left) + 16;
+        }
+
+        DrawTextLayer(textDC, surface, textMask, displayText, &itemRect,
+                      DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS, textColor);
     }
 
-    // Cleanup
-    SelectObject(hdc, hOldFont);
-    SelectObject(hdc, hOldPen);
-    DeleteObject(hFont);
-    DeleteObject(hPen);
+    // Antialiased rounded corners with a subtle border along the outline
+    ArgbRoundCorners(surface, 8.0f, 2.0f, ToArgb(RGB(80, 80, 80), 255));
+}
+
+// Rasterize text into the coverage mask with GDI, then composite it onto the
+// frame in the given color. GDI leaves alpha untouched, which is why text
+// cannot be drawn into the ARGB frame directly
+void DrawTextLayer(HDC textDC, ArgbSurface* surface, ArgbSurface* textMask,
+                   const wchar_t* text, RECT* rect, UINT format, COLORREF color)
+{
+    DrawTextW(textDC, text, -1, rect, format);
+    GdiFlush(); // Make sure GDI has written the pixels before we read them
+    ArgbBlendCoverage(surface, textMask, rect->left, rect->top, rect->right, rect->bottom,
+                      ToArgb(color, 255));
+}
+
+// Convert a GDI color and opacity into a premultiplied ARGB pixel
+uint32_t ToArgb(COLORREF color, BYTE alpha)
+{
+    return ArgbPremultiply(GetRValue(color), GetGValue(color), GetBValue(color), alpha);
 }
 
 // Focus the currently selected window
@@ -586,56 +1317,234 @@ void FocusSelectedWindow()
         return;
     }
 
-    HWND targetHwnd = g_windows[g_selectedIndex].hwnd;
-    
+    FocusWindow(g_windows[g_selectedIndex].hwnd);
+}
+
+// Bring a window to the foreground, restoring it if minimized. Strategies
+// are tried from cheapest to most intrusive until the target really is the
+// foreground window or the time budget runs out
+BOOL FocusWindow(HWND targetHwnd)
+{
     // Check if window is still valid
     if (!IsWindow(targetHwnd)) {
-        return;
+        return FALSE;
     }
 
-    // Restore window if minimized
+    LARGE_INTEGER start, now, frequency;
+    QueryPerformanceCounter(&start);
+    QueryPerformanceFrequency(&frequency);
+    LONGLONG budgetEnd = start.QuadPart + frequency.QuadPart * ACTIVATION_BUDGET_MS / 1000;
+
+    // Restore window if minimized. The async call only posts the request,
+    // so a hung target cannot block the UI thread
     if (IsIconic(targetHwnd)) {
-        ShowWindow(targetHwnd, SW_RESTORE);
+        ShowWindowAsync(targetHwnd, SW_RESTORE);
     }
 
-    // Bring window to foreground
-    SetForegroundWindow(targetHwnd);
-    SetFocus(targetHwnd);
-}
+    // A hung window cannot process activation anyway; skip the intrusive
+    // strategies that would act on its thread
+    BOOL hung = IsHungAppWindow(targetHwnd);
 
-// Swap two windows in the list for reordering functionality
-void SwapWindows(int index1, int index2)
-{
-    if (!g_windows || index1 < 0 || index2 < 0 || 
-        index1 >= g_windowCount || index2 >= g_windowCount || 
-        index1 == index2) {
-        return;
-    }
+    // The direct call is only permitted while our process owns the
+    // foreground, which is the normal case with the overlay open
+    DWORD foregroundProcess = 0;
+    GetWindowThreadProcessId(GetForegroundWindow(), &foregroundProcess);
+    int first = (foregroundProcess == GetCurrentProcessId()) ? ACTIVATE_DIRECT : ACTIVATE_SYNTHETIC_INPUT;
 
-    // Swap the WindowInfo structures
-    WindowInfo temp = g_windows[index1];
-    g_windows[index1] = g_windows[index2];
-    g_windows[index2] = temp;
-}
+    BOOL activated = FALSE;
+    int strategy = first;
+    for (; strategy < ACTIVATE_STRATEGY_COUNT; strategy++) {
+        QueryPerformanceCounter(&now);
+        if (now.QuadPart >= budgetEnd) break;
+        if (hung && (strategy == ACTIVATE_ATTACH_INPUT || strategy == ACTIVATE_MINIMIZE_RESTORE)) break;
 
-// Find a window in the current list by HWND
-int FindWindowInList(HWND hwnd)
-{
-    for (int i = 0; i < g_windowCount; i++) {
-        if (g_windows[i].hwnd == hwnd) {
-            return i;
+        LONGLONG strategyStart = now.QuadPart;
+        LONGLONG deadline = strategyStart + frequency.QuadPart * ACTIVATION_CONFIRM_MS / 1000;
+        if (deadline > budgetEnd) deadline = budgetEnd;
+
+        TryActivation((ActivationStrategy)strategy, targetHwnd);
+        activated = WaitForForeground(targetHwnd, deadline);
+
+        QueryPerformanceCounter(&now);
+        LONGLONG micros = (now.QuadPart - strategyStart) * 1000000 / frequency.QuadPart;
+        ActivationStats* stats = &g_activationStats[strategy];
+        stats->attempts++;
+        g_activationStatsDirty = TRUE;
+        stats->totalMicros += micros;
+        if (activated) {
+            stats->successes++;
+            stats->successMicros += micros;
+            break;
         }
     }
-    return -1; // Not found
+
+    // Log the outcome (view with DebugView or a debugger)
+    QueryPerformanceCounter(&now);
+    LONGLONG micros = (now.QuadPart - start.QuadPart) * 1000000 / frequency.QuadPart;
+    wchar_t activationMsg[120];
+    if (activated) {
+        wsprintfW(activationMsg, L"WinManager: activated via %S in %d.%03d ms\n",
+                  g_activationStats[strategy].name, (int)(micros / 1000), (int)(micros % 1000));
+    } else {
+        wsprintfW(activationMsg, L"WinManager: activation failed after %d.%03d ms\n",
+                  (int)(micros / 1000), (int)(micros % 1000));
+    }
+    OutputDebugStringW(activationMsg);
+
+    return activated;
 }
 
-// Update window list while preserving custom order
-void UpdateWindowList()
+// Perform one activation strategy without waiting for its effect
+void TryActivation(ActivationStrategy strategy, HWND targetHwnd)
 {
-    // Create a temporary list of all current valid windows
-    WindowInfo* tempWindows = NULL;
-    int tempCount = 0;
-    
+    switch (strategy) {
+    case ACTIVATE_DIRECT:
+        SetForegroundWindow(targetHwnd);
+        break;
+
+    case ACTIVATE_SYNTHETIC_INPUT:
+        {
+            // Windows lets the process that received the last input event set
+            // the foreground window. Send the release of an unassigned key:
+            // unlike an Alt tap it cannot open menus or Office KeyTips
+            INPUT input = { };
+            input.type = INPUT_KEYBOARD;
+            input.ki.wVk = 0xE8;  // Unassigned virtual key
+            input.ki.dwFlags = KEYEVENTF_KEYUP;
+            SendInput(1, &input, sizeof(INPUT));
+            SetForegroundWindow(targetHwnd);
+        }
+        break;
+
+    case ACTIVATE_ATTACH_INPUT:
+        {
+            // Attached threads share foreground and focus state
+            DWORD currentThread = GetCurrentThreadId();
+            DWORD foregroundThread = GetWindowThreadProcessId(GetForegroundWindow(), NULL);
+            BOOL attached = foregroundThread && foregroundThread != currentThread &&
+                            AttachThreadInput(currentThread, foregroundThread, TRUE);
+            BringWindowToTop(targetHwnd);
+            SetForegroundWindow(targetHwnd);
+            SetFocus(targetHwnd);
+            if (attached) {
+                AttachThreadInput(currentThread, foregroundThread, FALSE);
+            }
+        }
+        break;
+
+    case ACTIVATE_MINIMIZE_RESTORE:
+        // Restoring a minimized window activates it regardless of the lock.
+        // The target processes both requests in order
+        ShowWindowAsync(targetHwnd, SW_MINIMIZE);
+        ShowWindowAsync(targetHwnd, SW_RESTORE);
+        break;
+
+    default:
+        break;
+    }
+}
+
+// Check whether the target (or a window it owns, such as a dialog) is the
+// current foreground window
+BOOL IsForegroundTarget(HWND targetHwnd)
+{
+    HWND foreground = GetForegroundWindow();
+    if (foreground == targetHwnd) return TRUE;
+    return foreground != NULL && GetAncestor(foreground, GA_ROOTOWNER) == GetAncestor(targetHwnd, GA_ROOTOWNER);
+}
+
+// Poll the foreground window until the target has it or the deadline passes.
+// This blocks the message loop on purpose: each wait is capped by
+// ACTIVATION_CONFIRM_MS and the whole switch by ACTIVATION_BUDGET_MS, and the
+// answer decides whether the next strategy is needed at all
+BOOL WaitForForeground(HWND targetHwnd, LONGLONG deadline)
+{
+    LARGE_INTEGER now;
+    for (;;) {
+        if (IsForegroundTarget(targetHwnd)) return TRUE;
+        QueryPerformanceCounter(&now);
+        if (now.QuadPart >= deadline) return FALSE;
+        Sleep(1);
+    }
+}
+
+// Save per-strategy activation results to a simple text file
+void SaveActivationStats()
+{
+    FILE* file = fopen("winmanager_activation.txt", "w");
+    if (!file) return;
+
+    fprintf(file, "# strategy attempts successes total_us success_us\n");
+    for (int i = 0; i < ACTIVATE_STRATEGY_COUNT; i++) {
+        const ActivationStats* stats = &g_activationStats[i];
+        fprintf(file, "%s %d %d %lld %lld\n", stats->name, stats->attempts, stats->successes,
+                stats->totalMicros, stats->successMicros);
+    }
+
+    fclose(file);
+    g_activationStatsDirty = FALSE;
+}
+
+// Load activation results from previous runs so rates accumulate
+void LoadActivationStats()
+{
+    FILE* file = fopen("winmanager_activation.txt", "r");
+    if (!file) return;
+
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        char name[64];
+        ActivationStats loaded;
+        if (sscanf(line, "%63s %d %d %lld %lld", name, &loaded.attempts, &loaded.successes,
+                   &loaded.totalMicros, &loaded.successMicros) != 5) {
+            continue; // Header or malformed line
+        }
+        for (int i = 0; i < ACTIVATE_STRATEGY_COUNT; i++) {
+            if (strcmp(name, g_activationStats[i].name) == 0) {
+                g_activationStats[i].attempts = loaded.attempts;
+                g_activationStats[i].successes = loaded.successes;
+                g_activationStats[i].totalMicros = loaded.totalMicros;
+                g_activationStats[i].successMicros = loaded.successMicros;
+            }
+        }
+    }
+
+    fclose(file);
+}
+
+// Swap two windows in the list for reordering functionality
+void SwapWindows(int index1, int index2)
+{
+    if (!g_windows || index1 < 0 || index2 < 0 || 
+        index1 >= g_windowCount || index2 >= g_windowCount || 
+        index1 == index2) {
+        return;
+    }
+
+    // Swap the WindowInfo structures
+    WindowInfo temp = g_windows[index1];
+    g_windows[index1] = g_windows[index2];
+    g_windows[index2] = temp;
+}
+
+// Find a window in the current list by HWND
+int FindWindowInList(HWND hwnd)
+{
+    for (int i = 0; i < g_windowCount; i++) {
+        if (g_windows[i].hwnd == hwnd) {
+            return i;
+        }
+    }
+    return -1; // Not found
+}
+
+// Update window list while preserving custom order
+void UpdateWindowList()
+{
+    // Create a temporary list of all current valid windows
+    WindowInfo* tempWindows = NULL;
+    int tempCount = 0;
+    
     // Enumerate all current windows
     HWND hwnd = GetTopWindow(NULL);
     while (hwnd != NULL) {
@@ -648,6 +1557,7 @@ void UpdateWindowList()
             tempWindows[tempCount].hwnd = hwnd;
             GetWindowTextW(hwnd, tempWindows[tempCount].title, 256);
             GetClassNameW(hwnd, tempWindows[tempCount].className, 256);
+            GetWindowThreadProcessId(hwnd, &tempWindows[tempCount].processId);
             tempCount++;
         }
         hwnd = GetNextWindow(hwnd, GW_HWNDNEXT);
@@ -784,6 +1694,7 @@ void LoadWindowOrder()
             savedWindows[loadedCount].hwnd = hwnd;
             wcscpy(savedWindows[loadedCount].title, title);
             GetClassNameW(hwnd, savedWindows[loadedCount].className, 256);
+            GetWindowThreadProcessId(hwnd, &savedWindows[loadedCount].processId);
             loadedCount++;
         }
     }
@@ -797,4 +1708,893 @@ void LoadWindowOrder()
     } else {
         free(savedWindows);
     }
-}
\ No newline at end of file
+}
+
+// Build the file name for a named workspace snapshot
+void GetSnapshotPath(const wchar_t* name, wchar_t* path, int size)
+{
+    _snwprintf(path, size, L"winmanager_snapshot_%ls.bin", name);
+    path[size - 1] = L'\0';
+}
+
+// Get the executable file name (without directory) of a window's process
+void GetWindowExeName(HWND hwnd, wchar_t* exeName, DWORD size)
+{
+    exeName[0] = L'\0';
+
+    DWORD processId = 0;
+    GetWindowThreadProcessId(hwnd, &processId);
+    HANDLE process = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+    if (!process) return;
+
+    wchar_t path[MAX_PATH];
+    DWORD length = MAX_PATH;
+    if (QueryFullProcessImageNameW(process, 0, path, &length)) {
+        const wchar_t* baseName = wcsrchr(path, L'\\');
+        baseName = baseName ? baseName + 1 : path;
+        lstrcpynW(exeName, baseName, size);
+    }
+    CloseHandle(process);
+}
+
+// Enumerate the windows a snapshot covers: the tab list's filter, but
+// minimized windows too, so their state can be saved and restored.
+// Returns a malloc'd array in z-order (caller frees) or NULL if none
+WindowInfo* CollectSnapshotWindows(int* count)
+{
+    WindowInfo* windows = NULL;
+    *count = 0;
+
+    HWND hwnd = GetTopWindow(NULL);
+    while (hwnd != NULL) {
+        if (IsApplicationWindow(hwnd, TRUE)) {
+            WindowInfo* grown = (WindowInfo*)realloc(windows, (*count + 1) * sizeof(WindowInfo));
+            if (!grown) break;
+            windows = grown;
+
+            windows[*count].hwnd = hwnd;
+            GetWindowTextW(hwnd, windows[*count].title, 256);
+            GetClassNameW(hwnd, windows[*count].className, 256);
+            GetWindowThreadProcessId(hwnd, &windows[*count].processId);
+            (*count)++;
+        }
+        hwnd = GetNextWindow(hwnd, GW_HWNDNEXT);
+    }
+    return windows;
+}
+
+// Save the placement, monitor and min/max state of every application window,
+// including minimized ones the tab list leaves out
+BOOL SaveWorkspaceSnapshot(const wchar_t* name)
+{
+    int windowCount;
+    WindowInfo* windows = CollectSnapshotWindows(&windowCount);
+    if (!windows) return FALSE;
+
+    wchar_t path[MAX_PATH];
+    GetSnapshotPath(name, path, MAX_PATH);
+    FILE* file = _wfopen(path, L"wb");
+    if (!file) {
+        free(windows);
+        return FALSE;
+    }
+
+    SnapshotHeader header = {SNAPSHOT_MAGIC, SNAPSHOT_VERSION, 0};
+    fwrite(&header, sizeof(header), 1, file);
+
+    for (int i = 0; i < windowCount; i++) {
+        HWND hwnd = windows[i].hwnd;
+        WINDOWPLACEMENT placement = { };
+        placement.length = sizeof(WINDOWPLACEMENT);
+        if (!GetWindowPlacement(hwnd, &placement)) continue;
+
+        SnapshotEntry entry = { };
+        entry.showCmd = placement.showCmd;
+        entry.flags = placement.flags;
+        entry.normalRect = placement.rcNormalPosition;
+        if (IsIconic(hwnd)) {
+            entry.windowRect = placement.rcNormalPosition; // Actual rect is parked at -32000
+        } else {
+            GetWindowRect(hwnd, &entry.windowRect);
+        }
+
+        MONITORINFO monitor = { };
+        monitor.cbSize = sizeof(MONITORINFO);
+        GetMonitorInfoW(MonitorFromWindow(hwnd, MONITOR_DEFAULTTONEAREST), &monitor);
+        entry.monitorRect = monitor.rcMonitor;
+
+        wchar_t exeName[MAX_PATH];
+        GetWindowExeName(hwnd, exeName, MAX_PATH);
+        entry.classLength = (UINT16)wcslen(windows[i].className);
+        entry.titleLength = (UINT16)wcslen(windows[i].title);
+        entry.exeLength = (UINT16)wcslen(exeName);
+
+        fwrite(&entry, sizeof(entry), 1, file);
+        fwrite(windows[i].className, sizeof(wchar_t), entry.classLength, file);
+        fwrite(windows[i].title, sizeof(wchar_t), entry.titleLength, file);
+        fwrite(exeName, sizeof(wchar_t), entry.exeLength, file);
+        header.count++;
+    }
+
+    // Patch in the number of entries actually written
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    BOOL ok = !ferror(file);
+    fclose(file);
+    free(windows);
+    return ok;
+}
+
+// Copy a length-prefixed UTF-16 string out of a snapshot buffer
+BOOL ReadSnapshotString(const BYTE** cursor, const BYTE* end, int length, wchar_t* out, int size)
+{
+    size_t bytes = (size_t)length * sizeof(wchar_t);
+    if (length >= size || (size_t)(end - *cursor) < bytes) return FALSE;
+
+    memcpy(out, *cursor, bytes);
+    out[length] = L'\0';
+    *cursor += bytes;
+    return TRUE;
+}
+
+// Restore a named snapshot onto the live windows. Every window is matched
+// to an entry (class and executable must agree, an identical title wins),
+// then all placements are applied in one pass: plain moves go into a single
+// DeferWindowPos batch, windows that change min/max state use
+// SetWindowPlacement. Returns the number of windows placed, or -1 on error
+int RestoreWorkspaceSnapshot(const wchar_t* name)
+{
+    LARGE_INTEGER start, end, frequency;
+    QueryPerformanceCounter(&start);
+
+    wchar_t path[MAX_PATH];
+    GetSnapshotPath(name, path, MAX_PATH);
+    FILE* file = _wfopen(path, L"rb");
+    if (!file) return -1;
+
+    // Read the whole file at once, snapshots are small
+    fseek(file, 0, SEEK_END);
+    long fileSize = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    BYTE* data = (fileSize > 0) ? (BYTE*)malloc(fileSize) : NULL;
+    if (!data || fread(data, 1, fileSize, file) != (size_t)fileSize) {
+        free(data);
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+
+    SnapshotHeader header;
+    if ((size_t)fileSize < sizeof(header)) {
+        free(data);
+        return -1;
+    }
+    memcpy(&header, data, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.count == 0) {
+        free(data);
+        return -1;
+    }
+
+    // The count comes from disk: never allocate more entries than the file
+    // could possibly hold
+    size_t maxCount = ((size_t)fileSize - sizeof(header)) / sizeof(SnapshotEntry);
+    if (header.count > maxCount) header.count = (UINT32)maxCount;
+    if (header.count == 0) {
+        free(data);
+        return -1;
+    }
+
+    // Parse entries
+    SnapshotItem* items = (SnapshotItem*)malloc(header.count * sizeof(SnapshotItem));
+    if (!items) {
+        free(data);
+        return -1;
+    }
+    int itemCount = 0;
+    const BYTE* cursor = data + sizeof(header);
+    const BYTE* dataEnd = data + fileSize;
+    while (itemCount < (int)header.count && (size_t)(dataEnd - cursor) >= sizeof(SnapshotEntry)) {
+        SnapshotItem* item = &items[itemCount];
+        memcpy(&item->entry, cursor, sizeof(SnapshotEntry));
+        cursor += sizeof(SnapshotEntry);
+        if (!ReadSnapshotString(&cursor, dataEnd, item->entry.classLength, item->className, 256) ||
+            !ReadSnapshotString(&cursor, dataEnd, item->entry.titleLength, item->title, 256) ||
+            !ReadSnapshotString(&cursor, dataEnd, item->entry.exeLength, item->exeName, MAX_PATH)) {
+            break; // Truncated or corrupt, keep what parsed cleanly
+        }
+        item->matched = FALSE;
+        itemCount++;
+    }
+    free(data);
+
+    // Match live windows to entries: exact title first, then any entry of
+    // the same application so windows with changed titles still land
+    int windowCount;
+    WindowInfo* windows = CollectSnapshotWindows(&windowCount);
+    int* matches = (int*)malloc((windowCount > 0 ? windowCount : 1) * sizeof(int));
+    wchar_t (*exeNames)[MAX_PATH] = (wchar_t (*)[MAX_PATH])malloc((windowCount > 0 ? windowCount : 1) * sizeof(*exeNames));
+    if (!matches || !exeNames) {
+        free(matches);
+        free(exeNames);
+        free(windows);
+        free(items);
+        return -1;
+    }
+    for (int i = 0; i < windowCount; i++) {
+        matches[i] = -1;
+        GetWindowExeName(windows[i].hwnd, exeNames[i], MAX_PATH);
+    }
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < windowCount; i++) {
+            if (matches[i] >= 0) continue;
+            for (int j = 0; j < itemCount; j++) {
+                if (items[j].matched) continue;
+                if (wcscmp(items[j].className, windows[i].className) != 0) continue;
+                if (_wcsicmp(items[j].exeName, exeNames[i]) != 0) continue;
+                if (pass == 0 && wcscmp(items[j].title, windows[i].title) != 0) continue;
+                items[j].matched = TRUE;
+                matches[i] = j;
+                break;
+            }
+        }
+    }
+
+    // Apply every placement in a single pass
+    int placedCount = 0;
+    HDWP batch = BeginDeferWindowPos(windowCount);
+    for (int i = 0; i < windowCount; i++) {
+        if (matches[i] < 0) continue;
+        HWND hwnd = windows[i].hwnd;
+        SnapshotEntry* entry = &items[matches[i]].entry;
+
+        // If the monitor is gone, carry the window over to the primary one
+        RECT normalRect = entry->normalRect;
+        RECT windowRect = entry->windowRect;
+        if (!MonitorFromRect(&entry->monitorRect, MONITOR_DEFAULTTONULL)) {
+            POINT origin = {0, 0};
+            MONITORINFO primary = { };
+            primary.cbSize = sizeof(MONITORINFO);
+            GetMonitorInfoW(MonitorFromPoint(origin, MONITOR_DEFAULTTOPRIMARY), &primary);
+            int dx = primary.rcMonitor.left - entry->monitorRect.left;
+            int dy = primary.rcMonitor.top - entry->monitorRect.top;
+            OffsetRect(&normalRect, dx, dy);
+            OffsetRect(&windowRect, dx, dy);
+        }
+
+        WINDOWPLACEMENT placement = { };
+        placement.length = sizeof(WINDOWPLACEMENT);
+        GetWindowPlacement(hwnd, &placement);
+        BOOL stateMatches = (placement.showCmd == SW_SHOWNORMAL || placement.showCmd == SW_SHOW) &&
+                            entry->showCmd == SW_SHOWNORMAL;
+
+        if (stateMatches && batch) {
+            // Plain move/resize, batched so all windows update together
+            batch = DeferWindowPos(batch, hwnd, NULL, windowRect.left, windowRect.top,
+                                   windowRect.right - windowRect.left, windowRect.bottom - windowRect.top,
+                                   SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE);
+            if (!batch) {
+                // Out of resources: the batch is gone, place this one directly
+                // and let the rest fall back to SetWindowPlacement
+                SetWindowPos(hwnd, NULL, windowRect.left, windowRect.top,
+                             windowRect.right - windowRect.left, windowRect.bottom - windowRect.top,
+                             SWP_NOZORDER | SWP_NOOWNERZORDER | SWP_NOACTIVATE);
+            }
+        } else {
+            // Min/max state changes need the full placement
+            placement.flags = entry->flags;
+            // Restoring must not pull focus around; only maximizing has no
+            // non-activating form
+            if (entry->showCmd == SW_SHOWMINIMIZED) {
+                placement.showCmd = SW_SHOWMINNOACTIVE;
+            } else if (entry->showCmd == SW_SHOWNORMAL) {
+                placement.showCmd = SW_SHOWNOACTIVATE;
+            } else {
+                placement.showCmd = entry->showCmd;
+            }
+            placement.rcNormalPosition = normalRect;
+            placement.ptMinPosition.x = placement.ptMinPosition.y = -1;
+            placement.ptMaxPosition.x = placement.ptMaxPosition.y = -1;
+            SetWindowPlacement(hwnd, &placement);
+        }
+        placedCount++;
+    }
+    if (batch) {
+        EndDeferWindowPos(batch);
+    }
+
+    free(matches);
+    free(exeNames);
+    free(windows);
+    free(items);
+
+    // Log restore time (view with DebugView or a debugger)
+    QueryPerformanceCounter(&end);
+    QueryPerformanceFrequency(&frequency);
+    LONGLONG micros = (end.QuadPart - start.QuadPart) * 1000000 / frequency.QuadPart;
+    wchar_t timingMsg[120];
+    wsprintfW(timingMsg, L"WinManager: restored snapshot %s, %d of %d windows in %d.%03d ms\n",
+              name, placedCount, itemCount, (int)(micros / 1000), (int)(micros % 1000));
+    OutputDebugStringW(timingMsg);
+
+    return placedCount;
+}
+
+// Dispatch whatever is queued without blocking
+void PumpPendingMessages()
+{
+    MSG msg;
+    while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+        TranslateMessage(&msg);
+        DispatchMessage(&msg);
+    }
+}
+
+// Debug mode (--bench-restore N): open N throwaway top-level windows, mostly
+// normal with some minimized and maximized, snapshot them, then repeatedly
+// scramble their positions and states and time the restore. Any real
+// windows on the desktop are part of the snapshot too and are counted
+void RunRestoreBenchmark(HINSTANCE hInstance, int count)
+{
+    WNDCLASS wc = { };
+    wc.lpfnWndProc   = DefWindowProc;
+    wc.hInstance     = hInstance;
+    wc.lpszClassName = L"WinManagerBenchWindow";
+    wc.hbrBackground = (HBRUSH)(COLOR_WINDOW+1);
+    RegisterClass(&wc);
+
+    HWND* windows = (HWND*)calloc(count, sizeof(HWND));
+    if (!windows) return;
+    for (int i = 0; i < count; i++) {
+        wchar_t title[64];
+        wsprintfW(title, L"WinManager bench window %d", i + 1);
+        windows[i] = CreateWindowEx(0, wc.lpszClassName, title, WS_OVERLAPPEDWINDOW,
+                                    40 + (i % 20) * 30, 40 + (i / 20 % 10) * 30, 400 + (i % 7) * 20, 300,
+                                    NULL, NULL, hInstance, NULL);
+        int showCmd = (i % 10 == 3) ? SW_SHOWMINNOACTIVE : (i % 10 == 7) ? SW_SHOWMAXIMIZED : SW_SHOWNOACTIVATE;
+        ShowWindow(windows[i], showCmd);
+    }
+    PumpPendingMessages();
+    SaveWorkspaceSnapshot(L"bench");
+
+    LARGE_INTEGER start, end, frequency;
+    QueryPerformanceFrequency(&frequency);
+    LONGLONG bestMicros = 0;
+    LONGLONG totalMicros = 0;
+    int placedCount = 0;
+    for (int round = 0; round < BENCH_RESTORE_ROUNDS; round++) {
+        // Undo the snapshot: move normal windows, flip minimized and maximized
+        for (int i = 0; i < count; i++) {
+            if (i % 10 == 3) {
+                ShowWindow(windows[i], SW_SHOWNOACTIVATE);
+            } else if (i % 10 == 7) {
+                ShowWindow(windows[i], SW_SHOWMINNOACTIVE);
+            } else {
+                SetWindowPos(windows[i], NULL, 100 + round * 13 + (i % 5) * 50, 100 + (i % 9) * 40, 500, 350,
+                             SWP_NOZORDER | SWP_NOACTIVATE);
+            }
+        }
+        PumpPendingMessages();
+
+        QueryPerformanceCounter(&start);
+        placedCount = RestoreWorkspaceSnapshot(L"bench");
+        QueryPerformanceCounter(&end);
+        PumpPendingMessages();
+
+        LONGLONG micros = (end.QuadPart - start.QuadPart) * 1000000 / frequency.QuadPart;
+        totalMicros += micros;
+        if (round == 0 || micros < bestMicros) bestMicros = micros;
+    }
+
+    LONGLONG averageMicros = totalMicros / BENCH_RESTORE_ROUNDS;
+    wchar_t resultMsg[200];
+    wsprintfW(resultMsg, L"WinManager: restored %d windows (%d bench) in %d.%03d ms best, %d.%03d ms average over %d rounds\n",
+              placedCount, count, (int)(bestMicros / 1000), (int)(bestMicros % 1000),
+              (int)(averageMicros / 1000), (int)(averageMicros % 1000), BENCH_RESTORE_ROUNDS);
+    OutputDebugStringW(resultMsg);
+    MessageBox(NULL, resultMsg, L"WinManager restore benchmark", MB_OK);
+
+    for (int i = 0; i < count; i++) {
+        if (windows[i]) DestroyWindow(windows[i]);
+    }
+    free(windows);
+
+    wchar_t path[MAX_PATH];
+    GetSnapshotPath(L"bench", path, MAX_PATH);
+    DeleteFileW(path);
+}
+
+// Begin sampling process resources while the overlay is visible. The first
+// sample is taken on the next tick so showing the overlay is not delayed
+void StartResourceSampling(HWND hwnd)
+{
+    g_sampling = TRUE;
+    SetTimer(hwnd, TIMER_SAMPLE_RESOURCES, USER_TIMER_MINIMUM, NULL);
+}
+
+// Stop sampling; the hidden frame is re-rendered without resource columns
+// so stale figures are never presented on the next show
+void StopResourceSampling(HWND hwnd)
+{
+    KillTimer(hwnd, TIMER_SAMPLE_RESOURCES);
+    if (g_sampling) {
+        g_sampling = FALSE;
+        g_overlayDirty = TRUE;
+    }
+}
+
+// Sort samples by process ID
+int CompareProcessSamples(const void* a, const void* b)
+{
+    DWORD left = ((const ProcessSample*)a)->processId;
+    DWORD right = ((const ProcessSample*)b)->processId;
+    return (left > right) - (left < right);
+}
+
+// Look up the latest sample for a process. Samples left over from an
+// earlier showing of the overlay are ignored until the first new one lands
+const ProcessSample* FindProcessSample(DWORD processId)
+{
+    if (!g_samples || g_sampleCount == 0 || g_sampleTime == 0) return NULL;
+
+    LARGE_INTEGER now, frequency;
+    QueryPerformanceCounter(&now);
+    QueryPerformanceFrequency(&frequency);
+    if (now.QuadPart - g_sampleTime > frequency.QuadPart * RESOURCE_STALE_MS / 1000) return NULL;
+
+    ProcessSample key;
+    key.processId = processId;
+    return (const ProcessSample*)bsearch(&key, g_samples, g_sampleCount,
+                                         sizeof(ProcessSample), CompareProcessSamples);
+}
+
+// Take one system-wide sample of every process with a single
+// NtQuerySystemInformation call and compute CPU% against the previous one
+BOOL SampleProcesses()
+{
+    if (!g_ntQuerySystemInformation) {
+        g_ntQuerySystemInformation = (NtQuerySystemInformationFn)GetProcAddress(
+            GetModuleHandleW(L"ntdll.dll"), "NtQuerySystemInformation");
+        if (!g_ntQuerySystemInformation) return FALSE;
+    }
+
+    // Query, growing the reused buffer until the whole snapshot fits
+    NTSTATUS status;
+    ULONG needed = 0;
+    for (;;) {
+        if (g_processInfoBuffer) {
+            status = g_ntQuerySystemInformation(SYSTEM_PROCESS_INFORMATION_CLASS,
+                                                g_processInfoBuffer, g_processInfoSize, &needed);
+            if (status != STATUS_INFO_LENGTH_MISMATCH) break;
+        }
+        // Leave headroom for processes started between calls
+        ULONG size = (needed > g_processInfoSize ? needed : g_processInfoSize) + 64 * 1024;
+        BYTE* buffer = (BYTE*)realloc(g_processInfoBuffer, size);
+        if (!buffer) return FALSE;
+        g_processInfoBuffer = buffer;
+        g_processInfoSize = size;
+    }
+    if (status < 0) return FALSE; // Any NTSTATUS failure
+
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+
+    // The current pass becomes the previous one
+    ProcessSample* swap = g_previousSamples;
+    g_previousSamples = g_samples;
+    g_previousSampleCount = g_sampleCount;
+    g_previousSampleTime = g_sampleTime;
+    g_samples = swap;
+    g_sampleCount = 0;
+    g_sampleTime = now.QuadPart;
+
+    // Count entries so both arrays can hold them
+    int processCount = 0;
+    ULONG offset = 0;
+    for (;;) {
+        const SystemProcessEntry* entry = (const SystemProcessEntry*)(g_processInfoBuffer + offset);
+        processCount++;
+        if (entry->NextEntryOffset == 0) break;
+        offset += entry->NextEntryOffset;
+    }
+    if (processCount > g_sampleCapacity) {
+        ProcessSample* samples = (ProcessSample*)realloc(g_samples, processCount * sizeof(ProcessSample));
+        ProcessSample* previous = (ProcessSample*)realloc(g_previousSamples, processCount * sizeof(ProcessSample));
+        if (samples) g_samples = samples;
+        if (previous) g_previousSamples = previous;
+        if (!samples || !previous) {
+            g_previousSampleCount = 0;
+            return FALSE;
+        }
+        g_sampleCapacity = processCount;
+    }
+
+    offset = 0;
+    for (int i = 0; i < processCount; i++) {
+        const SystemProcessEntry* entry = (const SystemProcessEntry*)(g_processInfoBuffer + offset);
+        ProcessSample* sample = &g_samples[g_sampleCount++];
+        sample->processId = (DWORD)(ULONG_PTR)entry->UniqueProcessId;
+        sample->createTime = entry->CreateTime.QuadPart;
+        sample->cpuTime = entry->KernelTime.QuadPart + entry->UserTime.QuadPart;
+        sample->workingSet = entry->WorkingSetSize;
+        sample->cpuTenths = -1;
+        offset += entry->NextEntryOffset;
+    }
+    qsort(g_samples, g_sampleCount, sizeof(ProcessSample), CompareProcessSamples);
+
+    // CPU% as a delta from the previous pass, merging the two sorted lists.
+    // Normalized over all processors, like Task Manager
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    LONGLONG elapsed = g_sampleTime - g_previousSampleTime;
+    if (g_previousSampleCount == 0 || elapsed <= 0 ||
+        elapsed > frequency.QuadPart * RESOURCE_STALE_MS / 1000) {
+        return TRUE; // Memory only until the next pass
+    }
+
+    // Elapsed wall time across all processors, in 100ns units. GetSystemInfo
+    // would only count the current processor group (at most 64 CPUs)
+    DWORD processorCount = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    if (processorCount == 0) processorCount = 1;
+    double capacity = (double)elapsed * 10000000.0 / frequency.QuadPart * processorCount;
+
+    int j = 0;
+    for (int i = 0; i < g_sampleCount; i++) {
+        ProcessSample* sample = &g_samples[i];
+        while (j < g_previousSampleCount && g_previousSamples[j].processId < sample->processId) j++;
+        if (j >= g_previousSampleCount) break;
+
+        const ProcessSample* previous = &g_previousSamples[j];
+        if (previous->processId != sample->processId || previous->createTime != sample->createTime) {
+            continue; // New process, no baseline yet
+        }
+        if (sample->cpuTime < previous->cpuTime) continue;
+
+        int tenths = (int)((sample->cpuTime - previous->cpuTime) * 1000.0 / capacity + 0.5);
+        sample->cpuTenths = tenths > 1000 ? 1000 : tenths;
+    }
+    return TRUE;
+}
+
+// FNV-1a hash of a title, for the history lookup table
+UINT32 HashTitle(const wchar_t* title)
+{
+    UINT32 hash = 2166136261u;
+    for (; *title; title++) {
+        hash = (hash ^ (UINT32)*title) * 16777619u;
+    }
+    return hash;
+}
+
+// Find the slot holding this title, or the empty slot where it would go
+int FindHistorySlot(const wchar_t* title)
+{
+    int mask = g_historySlotCount - 1;
+    int slot = (int)(HashTitle(title) & (UINT32)mask);
+    while (g_historySlots[slot] >= 0 && wcscmp(g_history[g_historySlots[slot]].title, title) != 0) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// Size the title table for the current entry count and reinsert every entry
+BOOL RehashHistorySlots()
+{
+    int slotCount = 1024;
+    while (slotCount < g_historyCount * 2) slotCount *= 2;
+    int* slots = (int*)realloc(g_historySlots, slotCount * sizeof(int));
+    if (!slots) return FALSE;
+    g_historySlots = slots;
+    g_historySlotCount = slotCount;
+    for (int i = 0; i < slotCount; i++) g_historySlots[i] = -1;
+
+    for (int i = 0; i < g_historyCount; i++) {
+        g_historySlots[FindHistorySlot(g_history[i].title)] = i;
+    }
+    return TRUE;
+}
+
+// Rebuild the title table and trigram index from g_history, after loading
+// or eviction renumbered the entries
+BOOL RebuildHistoryLookup()
+{
+    if (!RehashHistorySlots()) return FALSE;
+
+    TrigramIndexFree(&g_historyIndex);
+    TrigramIndexInit(&g_historyIndex);
+    for (int i = 0; i < g_historyCount; i++) {
+        if (!TrigramIndexAdd(&g_historyIndex, (uint32_t)i, g_history[i].title)) return FALSE;
+    }
+    return TRUE;
+}
+
+// Append a new entry and index it
+BOOL AddHistoryEntry(HWND hwnd, const wchar_t* title, ULONGLONG firstSeen, ULONGLONG lastSeen)
+{
+    if (g_historyCount == g_historyCapacity) {
+        int capacity = g_historyCapacity ? g_historyCapacity * 2 : 256;
+        HistoryEntry* entries = (HistoryEntry*)realloc(g_history, capacity * sizeof(HistoryEntry));
+        if (!entries) return FALSE;
+        g_history = entries;
+        g_historyCapacity = capacity;
+    }
+
+    wchar_t* copy = _wcsdup(title);
+    if (!copy) return FALSE;
+
+    HistoryEntry* entry = &g_history[g_historyCount];
+    entry->hwnd = hwnd;
+    entry->firstSeen = firstSeen;
+    entry->lastSeen = lastSeen;
+    entry->title = copy;
+    g_historyCount++;
+
+    // Keep the title table at most half full. Growing it rehashes the new
+    // entry too; IDs are unchanged, so the trigram index only appends
+    if (g_historyCount * 2 > g_historySlotCount) {
+        if (!RehashHistorySlots()) return FALSE;
+    } else {
+        g_historySlots[FindHistorySlot(copy)] = g_historyCount - 1;
+    }
+    return TrigramIndexAdd(&g_historyIndex, (uint32_t)(g_historyCount - 1), copy);
+}
+
+// Note that a window currently shows this title. Titles already in the
+// history are refreshed in place, so churning titles do not pile up
+void RecordWindowHistory(HWND hwnd, const wchar_t* title)
+{
+    if (!title[0]) return;
+
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    ULONGLONG timestamp = ((ULONGLONG)now.dwHighDateTime << 32) | now.dwLowDateTime;
+
+    if (g_historySlotCount > 0) {
+        int slot = FindHistorySlot(title);
+        if (g_historySlots[slot] >= 0) {
+            HistoryEntry* entry = &g_history[g_historySlots[slot]];
+            entry->hwnd = hwnd;
+            entry->lastSeen = timestamp;
+            g_historyDirty = TRUE;
+            return;
+        }
+    }
+
+    g_historyDirty = TRUE;
+    if (g_historyCount >= HISTORY_MAX_ENTRIES) {
+        EvictHistory();
+    }
+    AddHistoryEntry(hwnd, title, timestamp, timestamp);
+}
+
+// An entry is live while its window is listed and still shows this title;
+// the HWND alone would also match every older title of the same window
+BOOL IsHistoryEntryLive(const HistoryEntry* entry)
+{
+    if (!entry->hwnd) return FALSE;
+    int index = FindWindowInList(entry->hwnd);
+    return index >= 0 && wcscmp(g_windows[index].title, entry->title) == 0;
+}
+
+// Order entry indexes by last seen, most recent first
+int CompareHistoryRecency(const void* a, const void* b)
+{
+    ULONGLONG left = g_history[*(const int*)a].lastSeen;
+    ULONGLONG right = g_history[*(const int*)b].lastSeen;
+    return (left < right) - (left > right);
+}
+
+// Drop the least recently seen quarter of the history
+void EvictHistory()
+{
+    int* order = (int*)malloc(g_historyCount * sizeof(int));
+    HistoryEntry* kept = (HistoryEntry*)malloc(g_historyCapacity * sizeof(HistoryEntry));
+    if (!order || !kept) {
+        free(order);
+        free(kept);
+        return;
+    }
+
+    for (int i = 0; i < g_historyCount; i++) order[i] = i;
+    qsort(order, g_historyCount, sizeof(int), CompareHistoryRecency);
+
+    // Keep the most recent three quarters, in their original order
+    int keepCount = g_historyCount - g_historyCount / 4;
+    BYTE* keep = (BYTE*)calloc(g_historyCount, 1);
+    if (!keep) {
+        free(order);
+        free(kept);
+        return;
+    }
+    for (int i = 0; i < keepCount; i++) keep[order[i]] = 1;
+
+    int count = 0;
+    for (int i = 0; i < g_historyCount; i++) {
+        if (keep[i]) {
+            kept[count++] = g_history[i];
+        } else {
+            free(g_history[i].title);
+        }
+    }
+    free(keep);
+    free(order);
+    free(g_history);
+    g_history = kept;
+    g_historyCount = count;
+
+    // Result indexes refer to the old numbering
+    g_historyResultCount = 0;
+    g_historySelected = 0;
+    RebuildHistoryLookup();
+}
+
+// Search the history for g_historyQuery. Queries of three or more
+// characters go through the trigram index; shorter ones scan
+void RunHistoryQuery()
+{
+    LARGE_INTEGER start, end, frequency;
+    QueryPerformanceCounter(&start);
+
+    g_historyResultCount = 0;
+    g_historySelected = 0;
+
+    uint32_t* candidates = NULL;
+    int candidateCount = TrigramIndexQuery(&g_historyIndex, g_historyQuery, &candidates);
+    int scanCount = candidateCount >= 0 ? candidateCount : g_historyCount;
+
+    int* results = (int*)realloc(g_historyResults, (scanCount > 0 ? scanCount : 1) * sizeof(int));
+    if (!results) {
+        free(candidates);
+        return;
+    }
+    g_historyResults = results;
+
+    for (int i = 0; i < scanCount; i++) {
+        int index = candidates ? (int)candidates[i] : i;
+        if (TrigramContains(g_history[index].title, g_historyQuery)) {
+            g_historyResults[g_historyResultCount++] = index;
+        }
+    }
+    free(candidates);
+
+    qsort(g_historyResults, g_historyResultCount, sizeof(int), CompareHistoryRecency);
+    if (g_historyResultCount > HISTORY_MAX_RESULTS) {
+        g_historyResultCount = HISTORY_MAX_RESULTS;
+    }
+
+    QueryPerformanceCounter(&end);
+    QueryPerformanceFrequency(&frequency);
+    g_historyQueryMicros = (end.QuadPart - start.QuadPart) * 1000000 / frequency.QuadPart;
+}
+
+// Switch the overlay to history search
+void EnterHistoryMode(HWND hwnd)
+{
+    g_historyMode = TRUE;
+    g_historyQuery[0] = L'\0';
+    RunHistoryQuery();
+    LayoutOverlay(hwnd);
+    RefreshOverlay(hwnd);
+}
+
+// Switch the overlay back to the window list
+void LeaveHistoryMode(HWND hwnd)
+{
+    g_historyMode = FALSE;
+    g_historyResultCount = 0;
+    LayoutOverlay(hwnd);
+    RefreshOverlay(hwnd);
+}
+
+// Draw the history search: query line, then matches with live ones marked
+void DrawHistoryList(HDC textDC, ArgbSurface* surface, ArgbSurface* textMask)
+{
+    ArgbFillRect(surface, 0, 0, surface->width, surface->height, ToArgb(RGB(59, 69, 79), 220));
+    ArgbFillRect(textMask, 0, 0, textMask->width, textMask->height, 0);
+
+    int itemHeight = 30;
+    int padding = 10;
+
+    wchar_t headerText[300];
+    wsprintfW(headerText, L"History: %s_   %d matches in %d.%03d ms - Enter: jump to live window, Esc: back",
+              g_historyQuery, g_historyResultCount,
+              (int)(g_historyQueryMicros / 1000), (int)(g_historyQueryMicros % 1000));
+    RECT headerRect = {5, 5, surface->width - 5, 25};
+    DrawTextLayer(textDC, surface, textMask, headerText, &headerRect,
+                  DT_LEFT | DT_TOP | DT_SINGLELINE | DT_END_ELLIPSIS, RGB(0, 0, 0));
+
+    // Scroll so the selection stays visible
+    int visibleRows = (surface->height - padding - 25) / itemHeight;
+    int first = g_historySelected >= visibleRows ? g_historySelected - visibleRows + 1 : 0;
+
+    for (int i = first; i < g_historyResultCount && i - first < visibleRows; i++) {
+        const HistoryEntry* entry = &g_history[g_historyResults[i]];
+        BOOL live = IsHistoryEntryLive(entry);
+
+        RECT itemRect;
+        itemRect.left = padding;
+        itemRect.right = surface->width - padding;
+        itemRect.top = padding + 25 + ((i - first) * itemHeight);
+        itemRect.bottom = itemRect.top + itemHeight;
+
+        COLORREF textColor;
+        if (i == g_historySelected) {
+            ArgbFillRect(surface, itemRect.left, itemRect.top, itemRect.right, itemRect.bottom,
+                         ToArgb(RGB(30, 3, 200), 255));
+            textColor = RGB(255, 255, 255);
+        } else {
+            textColor = live ? RGB(0, 0, 0) : RGB(150, 160, 170); // Closed windows are dimmed
+        }
+
+        wchar_t displayText[300];
+        if (live) {
+            wsprintfW(displayText, L"● %s (LIVE)", entry->title);
+        } else {
+            wsprintfW(displayText, L"    %s", entry->title);
+        }
+        DrawTextLayer(textDC, surface, textMask, displayText, &itemRect,
+                      DT_LEFT | DT_VCENTER | DT_SINGLELINE | DT_END_ELLIPSIS, textColor);
+    }
+
+    ArgbRoundCorners(surface, 8.0f, 2.0f, ToArgb(RGB(80, 80, 80), 255));
+}
+
+// Save the title history to a binary file
+void SaveHistory()
+{
+    if (g_historyCount == 0) return;
+
+    FILE* file = fopen("winmanager_history.bin", "wb");
+    if (!file) return;
+
+    HistoryHeader header = {HISTORY_MAGIC, HISTORY_VERSION, (UINT32)g_historyCount};
+    fwrite(&header, sizeof(header), 1, file);
+    for (int i = 0; i < g_historyCount; i++) {
+        HistoryRecord record = {g_history[i].firstSeen, g_history[i].lastSeen,
+                                (UINT32)wcslen(g_history[i].title), 0};
+        fwrite(&record, sizeof(record), 1, file);
+        fwrite(g_history[i].title, sizeof(wchar_t), record.titleLength, file);
+    }
+    fclose(file);
+    g_historyDirty = FALSE;
+}
+
+// Load the title history and build its index. Window handles are not
+// saved, they mean nothing after a restart
+void LoadHistory()
+{
+    TrigramIndexInit(&g_historyIndex);
+
+    FILE* file = fopen("winmanager_history.bin", "rb");
+    if (file) {
+        HistoryHeader header;
+        if (fread(&header, sizeof(header), 1, file) == 1 &&
+            header.magic == HISTORY_MAGIC && header.version == HISTORY_VERSION) {
+            wchar_t title[256];
+            for (UINT32 i = 0; i < header.count && g_historyCount < HISTORY_MAX_ENTRIES; i++) {
+                HistoryRecord record;
+                if (fread(&record, sizeof(record), 1, file) != 1 || record.titleLength >= 256) break;
+                if (fread(title, sizeof(wchar_t), record.titleLength, file) != record.titleLength) break;
+                title[record.titleLength] = L'\0';
+
+                // Append without indexing; everything is indexed at once below
+                if (g_historyCount == g_historyCapacity) {
+                    int capacity = g_historyCapacity ? g_historyCapacity * 2 : 256;
+                    HistoryEntry* entries = (HistoryEntry*)realloc(g_history, capacity * sizeof(HistoryEntry));
+                    if (!entries) break;
+                    g_history = entries;
+                    g_historyCapacity = capacity;
+                }
+                wchar_t* copy = _wcsdup(title);
+                if (!copy) break;
+                g_history[g_historyCount].hwnd = NULL;
+                g_history[g_historyCount].firstSeen = record.firstSeen;
+                g_history[g_historyCount].lastSeen = record.lastSeen;
+                g_history[g_historyCount].title = copy;
+                g_historyCount++;
+            }
+        }
+        fclose(file);
+    }
+
+    RebuildHistoryLookup();
+}
@@ -0,0 +1,238 @@
+#include "trigram.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <wctype.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define TRIGRAM_INITIAL_CAPACITY 1024  // Slots; grows at 50% load
+
+// Lower-case mapping for the Basic Multilingual Plane, built on first use
+static wchar_t g_foldTable[0x10000];
+static int g_foldTableReady = 0;
+
+static void BuildFoldTable()
+{
+    for (uint32_t i = 0; i < 0x10000; i++) {
+        g_foldTable[i] = (wchar_t)i;
+    }
+#ifdef _WIN32
+    // The CRT's towlower only folds ASCII in the default "C" locale, and
+    // nothing calls setlocale; the system mapping covers all of Unicode
+    CharLowerBuffW(g_foldTable, 0x10000);
+#else
+    // Follows LC_CTYPE, so the caller must set a Unicode locale
+    for (uint32_t i = 0; i < 0x10000; i++) {
+        g_foldTable[i] = (wchar_t)towlower((wint_t)i);
+    }
+#endif
+    g_foldTableReady = 1;
+}
+
+wchar_t TrigramFold(wchar_t c)
+{
+    if (!g_foldTableReady) BuildFoldTable();
+    if ((uint32_t)c >= 0x10000) return (wchar_t)towlower((wint_t)c);
+    return g_foldTable[(uint32_t)c];
+}
+
+// Pack three folded characters into a key. Bit 63 keeps it non-zero so 0
+// can mark an empty slot
+static uint64_t TrigramKey(const wchar_t* text)
+{
+    return (1ull << 63) |
+           ((uint64_t)(uint32_t)TrigramFold(text[0]) << 42) |
+           ((uint64_t)(uint32_t)TrigramFold(text[1]) << 21) |
+           (uint64_t)(uint32_t)TrigramFold(text[2]);
+}
+
+static uint32_t TrigramSlot(uint64_t key, uint32_t capacity)
+{
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32) & (capacity - 1);
+}
+
+// Find the slot holding key, or the empty slot where it would go
+static uint32_t FindSlot(const TrigramIndex* index, uint64_t key)
+{
+    uint32_t slot = TrigramSlot(key, index->capacity);
+    while (index->keys[slot] != 0 && index->keys[slot] != key) {
+        slot = (slot + 1) & (index->capacity - 1);
+    }
+    return slot;
+}
+
+static int Grow(TrigramIndex* index)
+{
+    uint32_t capacity = index->capacity ? index->capacity * 2 : TRIGRAM_INITIAL_CAPACITY;
+    uint64_t* keys = (uint64_t*)calloc(capacity, sizeof(uint64_t));
+    TrigramPostings* postings = (TrigramPostings*)calloc(capacity, sizeof(TrigramPostings));
+    if (!keys || !postings) {
+        free(keys);
+        free(postings);
+        return 0;
+    }
+
+    TrigramIndex grown = {keys, postings, capacity, index->count};
+    for (uint32_t i = 0; i < index->capacity; i++) {
+        if (index->keys[i] == 0) continue;
+        uint32_t slot = FindSlot(&grown, index->keys[i]);
+        keys[slot] = index->keys[i];
+        postings[slot] = index->postings[i];
+    }
+
+    free(index->keys);
+    free(index->postings);
+    *index = grown;
+    return 1;
+}
+
+// Append an ID to a posting list, skipping repeats within one document
+static int AppendPosting(TrigramPostings* list, uint32_t id)
+{
+    if (list->count > 0 && list->lastId == id) return 1;
+
+    if (list->size + 5 > list->capacity) {
+        uint32_t capacity = list->capacity ? list->capacity * 2 : 8;
+        uint8_t* data = (uint8_t*)realloc(list->data, capacity);
+        if (!data) return 0;
+        list->data = data;
+        list->capacity = capacity;
+    }
+
+    uint32_t delta = list->count > 0 ? id - list->lastId : id;
+    while (delta >= 0x80) {
+        list->data[list->size++] = (uint8_t)(delta | 0x80);
+        delta >>= 7;
+    }
+    list->data[list->size++] = (uint8_t)delta;
+    list->lastId = id;
+    list->count++;
+    return 1;
+}
+
+// Decode the next ID after previous; *position is the byte offset
+static uint32_t NextPosting(const TrigramPostings* list, uint32_t* position, uint32_t previous, int first)
+{
+    uint32_t delta = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+        byte = list->data[(*position)++];
+        delta |= (uint32_t)(byte & 0x7F) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return first ? delta : previous + delta;
+}
+
+void TrigramIndexInit(TrigramIndex* index)
+{
+    memset(index, 0, sizeof(*index));
+}
+
+void TrigramIndexFree(TrigramIndex* index)
+{
+    for (uint32_t i = 0; i < index->capacity; i++) {
+        if (index->keys[i] != 0) free(index->postings[i].data);
+    }
+    free(index->keys);
+    free(index->postings);
+    memset(index, 0, sizeof(*index));
+}
+
+int TrigramIndexAdd(TrigramIndex* index, uint32_t id, const wchar_t* text)
+{
+    size_t length = wcslen(text);
+    for (size_t i = 0; i + 3 <= length; i++) {
+        if ((index->count + 1) * 2 > index->capacity && !Grow(index)) return 0;
+
+        uint64_t key = TrigramKey(text + i);
+        uint32_t slot = FindSlot(index, key);
+        if (index->keys[slot] == 0) {
+            index->keys[slot] = key;
+            memset(&index->postings[slot], 0, sizeof(TrigramPostings));
+            index->count++;
+        }
+        if (!AppendPosting(&index->postings[slot], id)) return 0;
+    }
+    return 1;
+}
+
+int TrigramIndexQuery(const TrigramIndex* index, const wchar_t* query, uint32_t** candidates)
+{
+    *candidates = NULL;
+    size_t length = wcslen(query);
+    if (length < 3) return -1;
+    if (index->count == 0) return 0;
+
+    // Look up every trigram; a missing one means no document can match
+    size_t trigramCount = length - 2;
+    const TrigramPostings** lists = (const TrigramPostings**)malloc(trigramCount * sizeof(*lists));
+    if (!lists) return -1;
+    size_t shortest = 0;
+    for (size_t i = 0; i < trigramCount; i++) {
+        uint32_t slot = FindSlot(index, TrigramKey(query + i));
+        if (index->keys[slot] == 0) {
+            free(lists);
+            return 0;
+        }
+        lists[i] = &index->postings[slot];
+        if (lists[i]->count < lists[shortest]->count) shortest = i;
+    }
+
+    // Start from the shortest list, then intersect the others into it
+    uint32_t* result = (uint32_t*)malloc(lists[shortest]->count * sizeof(uint32_t));
+    if (!result) {
+        free(lists);
+        return -1;
+    }
+    uint32_t resultCount = 0;
+    uint32_t position = 0;
+    uint32_t id = 0;
+    for (uint32_t i = 0; i < lists[shortest]->count; i++) {
+        id = NextPosting(lists[shortest], &position, id, i == 0);
+        result[resultCount++] = id;
+    }
+
+    for (size_t i = 0; i < trigramCount && resultCount > 0; i++) {
+        if (i == shortest || lists[i] == lists[shortest]) continue;
+
+        const TrigramPostings* list = lists[i];
+        uint32_t kept = 0;
+        uint32_t decoded = 0;
+        position = 0;
+        id = 0;
+        int haveId = 0;
+        for (uint32_t r = 0; r < resultCount; r++) {
+            // Advance this list until it reaches the candidate
+            while ((!haveId || id < result[r]) && decoded < list->count) {
+                id = NextPosting(list, &position, id, decoded == 0);
+                decoded++;
+                haveId = 1;
+            }
+            if (haveId && id == result[r]) {
+                result[kept++] = result[r];
+            } else if (decoded == list->count && (!haveId || id < result[r])) {
+                break; // List exhausted, nothing further can match
+            }
+        }
+        resultCount = kept;
+    }
+
+    free(lists);
+    *candidates = result;
+    return (int)resultCount;
+}
+
+int TrigramContains(const wchar_t* text, const wchar_t* query)
+{
+    if (query[0] == 0) return 1;
+    for (; *text; text++) {
+        size_t i = 0;
+        while (query[i] && text[i] && TrigramFold(text[i]) == TrigramFold(query[i])) i++;
+        if (query[i] == 0) return 1;
+    }
+    return 0;
+}
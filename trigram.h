@@ -0,0 +1,51 @@
+#ifndef TRIGRAM_H
+#define TRIGRAM_H
+
+// Compact case-insensitive trigram index for substring search over window
+// titles. Every trigram maps to a posting list of ascending document IDs
+// stored as delta varints. A query intersects the posting lists of its
+// trigrams and returns candidates, which the caller confirms with
+// TrigramContains. Builds without Windows, like argb.c; on Windows the case
+// folding uses the system's Unicode mapping.
+
+#include <stddef.h>
+#include <stdint.h>
+#include <wchar.h>
+
+typedef struct {
+    uint8_t* data;       // Delta-varint encoded document IDs, ascending
+    uint32_t size;       // Bytes used
+    uint32_t capacity;   // Bytes allocated
+    uint32_t lastId;     // Last ID appended, for delta encoding
+    uint32_t count;      // Number of IDs
+} TrigramPostings;
+
+typedef struct {
+    uint64_t* keys;            // Open-addressing table, 0 marks an empty slot
+    TrigramPostings* postings; // Parallel to keys
+    uint32_t capacity;         // Power of two
+    uint32_t count;            // Distinct trigrams
+} TrigramIndex;
+
+void TrigramIndexInit(TrigramIndex* index);
+void TrigramIndexFree(TrigramIndex* index);
+
+// Index a document. IDs must be added in ascending order.
+// Returns 0 on allocation failure
+int TrigramIndexAdd(TrigramIndex* index, uint32_t id, const wchar_t* text);
+
+// Find documents that contain every trigram of the query. Returns the number
+// of candidates and a malloc'd array in *candidates (ascending, caller
+// frees), or -1 if the query is too short to use the index or allocation
+// failed; the caller then scans instead
+int TrigramIndexQuery(const TrigramIndex* index, const wchar_t* query, uint32_t** candidates);
+
+// Case folding used by the index. On Windows this is the system's mapping
+// (CharLowerBuffW), so "Ä" matches "ä" regardless of the CRT locale;
+// elsewhere it is towlower and follows LC_CTYPE at first use
+wchar_t TrigramFold(wchar_t c);
+
+// Case-insensitive substring test, used to confirm candidates
+int TrigramContains(const wchar_t* text, const wchar_t* query);
+
+#endif // TRIGRAM_H
@@ -0,0 +1,164 @@
+// Standalone benchmark for the history search index in trigram.c.
+//
+//   gcc -O2 trigram_bench.c trigram.c -o trigram_bench
+//
+// Indexes a full history of synthetic window titles, then runs a set of
+// queries both through the index and as a plain scan. The two must return
+// the same entries; any difference is reported and fails the run, as does
+// a non-ASCII query that fails to match across case.
+
+#include "trigram.h"
+
+#include <locale.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <wctype.h>
+
+// Same size as HISTORY_MAX_ENTRIES in main.c
+#define BENCH_TITLES 50000
+#define BENCH_TITLE_LENGTH 256
+#define BENCH_ITERATIONS 20
+
+static const wchar_t* g_words[] = {
+    L"Inbox", L"Visual Studio Code", L"main.c", L"README.md", L"Google Chrome",
+    L"Mozilla Firefox", L"Slack", L"Terminal", L"Pull request", L"Build failed",
+    L"Quarterly Report.xlsx", L"Meeting notes", L"Spotify", L"Calendar", L"Untitled",
+    L"Settings", L"Downloads", L"Task Manager", L"Äpfel und Birnen", L"DEBUG output"
+};
+
+#define WORD_COUNT (int)(sizeof(g_words) / sizeof(g_words[0]))
+
+static const wchar_t* g_queries[] = {
+    L"chrome", L"VISUAL", L"main.c", L"report", L"request #12", L"notes - s",
+    L"BIRNEN", L"äpfel", L"x", L"no such window", L"Inbox (1"
+};
+
+#define QUERY_COUNT (int)(sizeof(g_queries) / sizeof(g_queries[0]))
+
+static double NowSeconds()
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Title-like text: two words, usually with a counter, the way browsers and
+// editors decorate document names
+static void MakeTitle(wchar_t* title, int index)
+{
+    const wchar_t* first = g_words[rand() % WORD_COUNT];
+    const wchar_t* second = g_words[rand() % WORD_COUNT];
+    switch (index % 3) {
+    case 0:
+        swprintf(title, BENCH_TITLE_LENGTH, L"%ls - %ls", first, second);
+        break;
+    case 1:
+        swprintf(title, BENCH_TITLE_LENGTH, L"%ls (%d) - %ls", first, rand() % 100, second);
+        break;
+    default:
+        swprintf(title, BENCH_TITLE_LENGTH, L"%ls #%d - %ls", first, rand() % 1000, second);
+        break;
+    }
+}
+
+// Search like RunHistoryQuery: index candidates confirmed by substring test,
+// or a full scan when the query is too short for the index
+static int SearchIndexed(const TrigramIndex* index, wchar_t (*titles)[BENCH_TITLE_LENGTH],
+                         const wchar_t* query, uint32_t* results)
+{
+    uint32_t* candidates = NULL;
+    int candidateCount = TrigramIndexQuery(index, query, &candidates);
+    int scanCount = candidateCount >= 0 ? candidateCount : BENCH_TITLES;
+
+    int resultCount = 0;
+    for (int i = 0; i < scanCount; i++) {
+        uint32_t id = candidates ? candidates[i] : (uint32_t)i;
+        if (TrigramContains(titles[id], query)) results[resultCount++] = id;
+    }
+    free(candidates);
+    return resultCount;
+}
+
+static int SearchScan(wchar_t (*titles)[BENCH_TITLE_LENGTH], const wchar_t* query, uint32_t* results)
+{
+    int resultCount = 0;
+    for (int i = 0; i < BENCH_TITLES; i++) {
+        if (TrigramContains(titles[i], query)) results[resultCount++] = (uint32_t)i;
+    }
+    return resultCount;
+}
+
+int main()
+{
+    // Outside Windows the folding follows LC_CTYPE, which must be set before
+    // the first fold; without a Unicode locale only ASCII folds
+    if (!setlocale(LC_CTYPE, "") || towlower(L'Ä') != L'ä') {
+        setlocale(LC_CTYPE, "C.UTF-8");
+    }
+    wchar_t (*titles)[BENCH_TITLE_LENGTH] = (wchar_t (*)[BENCH_TITLE_LENGTH])malloc(sizeof(*titles) * BENCH_TITLES);
+    uint32_t* indexed = (uint32_t*)malloc(sizeof(uint32_t) * BENCH_TITLES);
+    uint32_t* scanned = (uint32_t*)malloc(sizeof(uint32_t) * BENCH_TITLES);
+    if (!titles || !indexed || !scanned) return 1;
+
+    srand(1);
+    for (int i = 0; i < BENCH_TITLES; i++) {
+        MakeTitle(titles[i], i);
+    }
+
+    TrigramIndex index;
+    TrigramIndexInit(&index);
+    double start = NowSeconds();
+    for (int i = 0; i < BENCH_TITLES; i++) {
+        if (!TrigramIndexAdd(&index, (uint32_t)i, titles[i])) return 1;
+    }
+    printf("%-16s %8.3f ms for %d titles, %u trigrams\n", "build",
+           (NowSeconds() - start) * 1000.0, BENCH_TITLES, index.count);
+
+    int mismatches = 0;
+    for (int q = 0; q < QUERY_COUNT; q++) {
+        const wchar_t* query = g_queries[q];
+        int indexedCount = 0;
+        int scannedCount = 0;
+
+        start = NowSeconds();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            indexedCount = SearchIndexed(&index, titles, query, indexed);
+        }
+        double indexedSeconds = NowSeconds() - start;
+
+        start = NowSeconds();
+        for (int i = 0; i < BENCH_ITERATIONS; i++) {
+            scannedCount = SearchScan(titles, query, scanned);
+        }
+        double scannedSeconds = NowSeconds() - start;
+
+        // Both lists are ascending, so they must agree element by element
+        int same = indexedCount == scannedCount;
+        for (int i = 0; same && i < indexedCount; i++) {
+            same = indexed[i] == scanned[i];
+        }
+        if (!same) mismatches++;
+
+        // Case folding beyond ASCII: "äpfel" must find "Äpfel und Birnen"
+        if (query[0] == L'ä' && indexedCount == 0) {
+            printf("non-ASCII case folding does not work\n");
+            mismatches++;
+        }
+
+        printf("%-16ls %8.3f ms/query %8.3f ms/scan %6d matches%s\n", query,
+               indexedSeconds * 1000.0 / BENCH_ITERATIONS, scannedSeconds * 1000.0 / BENCH_ITERATIONS,
+               indexedCount, same ? "" : "  MISMATCH");
+    }
+
+    TrigramIndexFree(&index);
+    free(titles);
+    free(indexed);
+    free(scanned);
+
+    if (mismatches > 0) {
+        printf("%d of %d queries disagree with the scan\n", mismatches, QUERY_COUNT);
+        return 1;
+    }
+    return 0;
+}